@@ -0,0 +1,200 @@
+#include "stdafx.h"
+#include "BehaviorTreeLoader.h"
+#include <sys/stat.h>
+
+BehaviorTreeLoader::BehaviorTreeLoader(const std::string& filePath)
+	: m_FilePath{ filePath }
+{
+}
+
+void BehaviorTreeLoader::RegisterConditional(const std::string& name, const std::function<bool(Elite::Blackboard*)>& fpConditional)
+{
+	m_Conditionals[name] = fpConditional;
+}
+
+void BehaviorTreeLoader::RegisterAction(const std::string& name, const std::function<Elite::BehaviorState(Elite::Blackboard*)>& fpAction)
+{
+	m_Actions[name] = fpAction;
+}
+
+void BehaviorTreeLoader::RegisterRoutine(const std::string& name, Elite::BehaviorRoutineFunction fpRoutine)
+{
+	m_Routines[name] = fpRoutine;
+}
+
+Elite::IBehavior* BehaviorTreeLoader::Load(Elite::BehaviorArena& arena)
+{
+	// Remember the write time of the version that we are loading
+	m_LastWriteTime = GetFileWriteTime();
+
+	// Read all the nodes from the file
+	std::vector<TreeLine> lines{};
+	if (!ReadLines(lines)) return nullptr;
+
+	// If the file is empty, there is no tree
+	if (lines.empty())
+	{
+		std::cout << "Behavior tree file " << m_FilePath << " is empty\n";
+		return nullptr;
+	}
+
+	// The routines of the tree share one pool, it is created first so it is destroyed last
+	Elite::BehaviorRoutinePool* pRoutinePool{ arena.Create<Elite::BehaviorRoutinePool>() };
+
+	// Parse the root and everything below it
+	size_t curLine{};
+	Elite::IBehavior* pRoot{ ParseNode(arena, pRoutinePool, lines, curLine) };
+	if (!pRoot) return nullptr;
+
+	// There can only be one root
+	if (curLine < lines.size())
+	{
+		std::cout << m_FilePath << "(" << lines[curLine].lineNumber << "): a behavior tree can only have one root\n";
+		return nullptr;
+	}
+
+	return pRoot;
+}
+
+bool BehaviorTreeLoader::HasFileChanged()
+{
+	// If the file does not exist (anymore), nothing changed
+	const long long writeTime{ GetFileWriteTime() };
+	if (writeTime == 0) return false;
+
+	return writeTime != m_LastWriteTime;
+}
+
+const std::string& BehaviorTreeLoader::GetFilePath() const
+{
+	return m_FilePath;
+}
+
+bool BehaviorTreeLoader::ReadLines(std::vector<TreeLine>& lines) const
+{
+	std::ifstream file{ m_FilePath };
+	if (!file.is_open())
+	{
+		std::cout << "Could not open behavior tree file " << m_FilePath << "\n";
+		return false;
+	}
+
+	std::string line{};
+	int lineNumber{};
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+
+		// Remove the comment
+		const size_t commentStart{ line.find('#') };
+		if (commentStart != std::string::npos) line.erase(commentStart);
+
+		// Count the indentation, a tab or two spaces is one level
+		int nrSpaces{};
+		size_t curChar{};
+		for (; curChar < line.size(); ++curChar)
+		{
+			if (line[curChar] == '\t') nrSpaces += 2;
+			else if (line[curChar] == ' ') ++nrSpaces;
+			else break;
+		}
+
+		// Skip empty lines
+		std::istringstream stream{ line.substr(curChar) };
+		TreeLine treeLine{};
+		if (!(stream >> treeLine.keyword)) continue;
+		stream >> treeLine.argument;
+
+		treeLine.depth = nrSpaces / 2;
+		treeLine.lineNumber = lineNumber;
+		lines.push_back(treeLine);
+	}
+
+	return true;
+}
+
+Elite::IBehavior* BehaviorTreeLoader::ParseNode(Elite::BehaviorArena& arena, Elite::BehaviorRoutinePool* pRoutinePool, const std::vector<TreeLine>& lines, size_t& curLine) const
+{
+	const TreeLine& line{ lines[curLine] };
+	++curLine;
+
+	// Leaves
+	if (line.keyword == "condition")
+	{
+		const auto it{ m_Conditionals.find(line.argument) };
+		if (it == m_Conditionals.end())
+		{
+			std::cout << m_FilePath << "(" << line.lineNumber << "): unknown condition '" << line.argument << "'\n";
+			return nullptr;
+		}
+		return arena.Create<Elite::BehaviorConditional>(it->second);
+	}
+	if (line.keyword == "action")
+	{
+		const auto it{ m_Actions.find(line.argument) };
+		if (it == m_Actions.end())
+		{
+			std::cout << m_FilePath << "(" << line.lineNumber << "): unknown action '" << line.argument << "'\n";
+			return nullptr;
+		}
+		return arena.Create<Elite::BehaviorAction>(it->second);
+	}
+	if (line.keyword == "routine")
+	{
+		const auto it{ m_Routines.find(line.argument) };
+		if (it == m_Routines.end())
+		{
+			std::cout << m_FilePath << "(" << line.lineNumber << "): unknown routine '" << line.argument << "'\n";
+			return nullptr;
+		}
+		return arena.Create<Elite::BehaviorCoroutine>(pRoutinePool, it->second);
+	}
+
+	// Composites, parse every line that is exactly one level deeper
+	std::vector<Elite::IBehavior*> childBehaviors{};
+	while (curLine < lines.size() && lines[curLine].depth > line.depth)
+	{
+		if (lines[curLine].depth != line.depth + 1)
+		{
+			std::cout << m_FilePath << "(" << lines[curLine].lineNumber << "): wrong indentation\n";
+			return nullptr;
+		}
+
+		Elite::IBehavior* pChild{ ParseNode(arena, pRoutinePool, lines, curLine) };
+		if (!pChild) return nullptr;
+
+		childBehaviors.push_back(pChild);
+	}
+
+	if (childBehaviors.empty())
+	{
+		std::cout << m_FilePath << "(" << line.lineNumber << "): '" << line.keyword << "' has no children\n";
+		return nullptr;
+	}
+
+	const unsigned int nrChildBehaviors{ static_cast<unsigned int>(childBehaviors.size()) };
+
+	if (line.keyword == "selector") return arena.CreateComposite<Elite::BehaviorSelector>(childBehaviors.data(), nrChildBehaviors);
+	if (line.keyword == "sequence") return arena.CreateComposite<Elite::BehaviorSequence>(childBehaviors.data(), nrChildBehaviors);
+	if (line.keyword == "partialsequence") return arena.CreateComposite<Elite::BehaviorPartialSequence>(childBehaviors.data(), nrChildBehaviors);
+	if (line.keyword == "invertor")
+	{
+		if (nrChildBehaviors != 1)
+		{
+			std::cout << m_FilePath << "(" << line.lineNumber << "): an invertor needs exactly one child\n";
+			return nullptr;
+		}
+		return arena.CreateComposite<Elite::BehaviorInvertor>(childBehaviors.data(), nrChildBehaviors);
+	}
+
+	std::cout << m_FilePath << "(" << line.lineNumber << "): unknown node '" << line.keyword << "'\n";
+	return nullptr;
+}
+
+long long BehaviorTreeLoader::GetFileWriteTime() const
+{
+	struct stat fileInfo {};
+	if (stat(m_FilePath.c_str(), &fileInfo) != 0) return 0;
+
+	return static_cast<long long>(fileInfo.st_mtime);
+}
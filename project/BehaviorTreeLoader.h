@@ -0,0 +1,47 @@
+#pragma once
+#include <unordered_map>
+#include "EBehaviorTree.h"
+#include "EBehaviorRoutine.h"
+
+// Builds a behavior tree from a text file
+//
+// Every line holds one node, children are indented one level deeper than their parent:
+//	selector
+//		sequence
+//			condition IsEnemyInFront
+//			action Shoot
+// Composites: selector, sequence, partialsequence, invertor
+// Leaves: condition <name>, action <name>, routine <name>
+// Everything after a '#' is a comment
+class BehaviorTreeLoader final
+{
+public:
+	BehaviorTreeLoader(const std::string& filePath);
+
+	void RegisterConditional(const std::string& name, const std::function<bool(Elite::Blackboard*)>& fpConditional);
+	void RegisterAction(const std::string& name, const std::function<Elite::BehaviorState(Elite::Blackboard*)>& fpAction);
+	void RegisterRoutine(const std::string& name, Elite::BehaviorRoutineFunction fpRoutine);
+
+	Elite::IBehavior* Load(Elite::BehaviorArena& arena);
+	bool HasFileChanged();
+	const std::string& GetFilePath() const;
+private:
+	struct TreeLine
+	{
+		int depth{};
+		int lineNumber{};
+		std::string keyword{};
+		std::string argument{};
+	};
+
+	bool ReadLines(std::vector<TreeLine>& lines) const;
+	Elite::IBehavior* ParseNode(Elite::BehaviorArena& arena, Elite::BehaviorRoutinePool* pRoutinePool, const std::vector<TreeLine>& lines, size_t& curLine) const;
+	long long GetFileWriteTime() const;
+
+	std::string m_FilePath{};
+	long long m_LastWriteTime{};
+
+	std::unordered_map<std::string, std::function<bool(Elite::Blackboard*)>> m_Conditionals{};
+	std::unordered_map<std::string, std::function<Elite::BehaviorState(Elite::Blackboard*)>> m_Actions{};
+	std::unordered_map<std::string, Elite::BehaviorRoutineFunction> m_Routines{};
+};
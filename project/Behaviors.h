@@ -5,9 +5,22 @@
 /*=============================================================================*/
 #include "EBlackboard.h"
 #include "EBehaviorTree.h"
+#include "EStaticBehaviorTree.h"
+#include "EBehaviorRoutine.h"
 #include "ExtendedStructs.h"
 #include "InventoryManager.h"
 #include "Steering.h"
+#include "BehaviorTreeLoader.h"
+#include "TaskScheduler.h"
+#include "Perception.h"
+#include "SweepPlanner.h"
+#include "LootTourPlanner.h"
+#include "EnemyTracker.h"
+#include "EnemyPredictor.h"
+#include "PathCache.h"
+#include "FrameArena.h"
+#include "ItemMemory.h"
+#include "HouseRegistry.h"
 #include <Exam_HelperStructs.h>
 #include <EliteMath/EVector2.h>
 #ifndef ELITE_APPLICATION_BEHAVIOR_TREE_BEHAVIORS
@@ -57,10 +70,16 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("EntityTarget", target))
 			return Elite::BehaviorState::Failure;
 
+		PathCache* pPathCache;
+		if (!pBlackboard->GetData("PathCache", pPathCache))
+			return Elite::BehaviorState::Failure;
+
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Get the closest navmesh point
-		const Elite::Vector2 nextTargetPos = pInterface->NavMesh_GetClosestPathPoint(target);
+		// Get the closest navmesh point, the path is only searched again when needed
+		Elite::Vector2 nextTargetPos;
+		if (!pPathCache->GetPathPoint(pBlackboard, "EntityTarget", pInterface, agentInfo.Position, nextTargetPos))
+			return Elite::BehaviorState::Failure;
 
 		// Add seek to the navmesh target
 		pSteering->AddSeek(nextTargetPos, agentInfo);
@@ -69,15 +88,8 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
 			return Elite::BehaviorState::Failure;
 
-		// If there is enough stamina, run
-		if (agentInfo.RunMode)
-		{
-			if (agentInfo.Stamina > 2.0f) pSteering->Run();
-		}
-		else
-		{
-			if (agentInfo.Stamina >= 10.0f) pSteering->Run();
-		}
+		// Run when the stamina scheduler thinks it is worth it
+		pSteering->RunTowards(target, agentInfo);
 
 		return Elite::BehaviorState::Success;
 	}
@@ -97,23 +109,22 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("HouseTarget", target))
 			return Elite::BehaviorState::Failure;
 
+		PathCache* pPathCache;
+		if (!pBlackboard->GetData("PathCache", pPathCache))
+			return Elite::BehaviorState::Failure;
+
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Get the closest navmesh point
-		const Elite::Vector2 nextTargetPos = pInterface->NavMesh_GetClosestPathPoint(target);
+		// Get the closest navmesh point, the path is only searched again when needed
+		Elite::Vector2 nextTargetPos;
+		if (!pPathCache->GetPathPoint(pBlackboard, "HouseTarget", pInterface, agentInfo.Position, nextTargetPos))
+			return Elite::BehaviorState::Failure;
 
 		// Add seek to the navmesh target
 		pSteering->AddSeek(nextTargetPos, agentInfo);
 
-		// If there is enough stamina, run
-		if (agentInfo.RunMode)
-		{
-			if (agentInfo.Stamina > 2.0f) pSteering->Run();
-		}
-		else
-		{
-			if (agentInfo.Stamina >= 10.0f) pSteering->Run();
-		}
+		// Run when the stamina scheduler thinks it is worth it
+		pSteering->RunTowards(target, agentInfo);
 
 		return Elite::BehaviorState::Success;
 	}
@@ -129,23 +140,19 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Steering", pSteering))
 			return Elite::BehaviorState::Failure;
 
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return Elite::BehaviorState::Failure;
 
-		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-
-		// Search for the purgezone
-		for (const EntityInfo& entity : *pEntityVec)
+		// Look at the closest purge zone
+		const std::vector<UINT>& purgeZones{ pPerception->GetPurgeZones() };
+		if (!purgeZones.empty())
 		{
-			if (entity.Type == eEntityType::PURGEZONE)
-			{
-				PurgeZoneInfo zoneInfo;
-				pInterface->PurgeZone_GetInfo(entity, zoneInfo);
+			PurgeZoneInfo zoneInfo;
+			pInterface->PurgeZone_GetInfo(pPerception->GetEntity(purgeZones[0]), zoneInfo);
 
-				// Look at the center of the purge zone
-				pSteering->LookAt(zoneInfo.Center);
-			}
+			// Look at the center of the purge zone
+			pSteering->LookAt(zoneInfo.Center);
 		}
 
 		return Elite::BehaviorState::Success;
@@ -158,19 +165,20 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Inventory", pInventory))
 			return Elite::BehaviorState::Failure;
 
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		EnemyPredictor* pEnemyPredictor;
+		if (!pBlackboard->GetData("EnemyPredictor", pEnemyPredictor))
 			return Elite::BehaviorState::Failure;
 
-		// Get nr of enemies
-		int nrEnemies{};
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Type == eEntityType::ENEMY) ++nrEnemies;
-		}
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return Elite::BehaviorState::Failure;
+
+		// The shotgun spends its ammo on every enemy in its cone
+		constexpr float shotgunRange{ 15.0f };
+		constexpr float shotgunHalfAngle{ 0.25f };
 
-		// When multiple enemies in fov, shoot with shotgun, else pistol if possible
-		if (nrEnemies > 1)
+		// When the shotgun would hit multiple enemies, shoot with shotgun, else pistol if possible
+		if (pEnemyPredictor->GetNrInCone(*pAgentInfo, shotgunRange, shotgunHalfAngle) > 1)
 		{
 			if (!pInventory->ShootShotgun())
 			{
@@ -185,101 +193,12 @@ namespace BT_Actions
 			}
 		}
 
-		// Reset looking for enemy
-		pBlackboard->ChangeData("LookForEnemyTimer", 0.0f);
+		// Stop looking for enemy
 		pBlackboard->ChangeData("LookingForEnemy", false);
 
 		return Elite::BehaviorState::Success;
 	}
 
-	// Only rotate from the current enemy
-	Elite::BehaviorState TurnToLookForEnemy(Elite::Blackboard* pBlackboard)
-	{
-		Steering* pSteering;
-		if (!pBlackboard->GetData("Steering", pSteering))
-			return Elite::BehaviorState::Failure;
-
-		IExamInterface* pInterface;
-		if (!pBlackboard->GetData("Interface", pInterface))
-			return Elite::BehaviorState::Failure;
-
-		Elite::Vector2 target;
-		if (!pBlackboard->GetData("EntityTarget", target))
-			return Elite::BehaviorState::Failure;
-
-		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-
-		// Force the agent to rotate
-		pSteering->Rotate(agentInfo.MaxAngularSpeed);
-
-		float lookingForEnemyTimer;
-		if (!pBlackboard->GetData("LookForEnemyTimer", lookingForEnemyTimer))
-			return Elite::BehaviorState::Failure;
-
-		float deltaTime;
-		if (!pBlackboard->GetData("DeltaTime", deltaTime))
-			return Elite::BehaviorState::Failure;
-
-		// Decrement the enemylook timer with deltatime
-		lookingForEnemyTimer -= deltaTime;
-
-		// Store the enemy look timer
-		pBlackboard->ChangeData("LookForEnemyTimer", lookingForEnemyTimer);
-
-		// If the look enemy timer is equal or less then zero, disable looking for an enemy
-		if (lookingForEnemyTimer <= 0)
-		{
-			pBlackboard->ChangeData("LookingForEnemy", false);
-		}
-
-		return Elite::BehaviorState::Success;
-	}
-
-	// Flee and rotate from the current enemy
-	Elite::BehaviorState LookForEnemy(Elite::Blackboard* pBlackboard)
-	{
-		Steering* pSteering;
-		if (!pBlackboard->GetData("Steering", pSteering))
-			return Elite::BehaviorState::Failure;
-
-		IExamInterface* pInterface;
-		if (!pBlackboard->GetData("Interface", pInterface))
-			return Elite::BehaviorState::Failure;
-
-		Elite::Vector2 target;
-		if (!pBlackboard->GetData("EntityTarget", target))
-			return Elite::BehaviorState::Failure;
-
-		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-
-		// Force the agent to rotate
-		pSteering->Rotate(agentInfo.MaxAngularSpeed);
-		// Flee from target
-		pSteering->AddFlee(target, agentInfo);
-
-		float lookingForEnemyTimer;
-		if (!pBlackboard->GetData("LookForEnemyTimer", lookingForEnemyTimer))
-			return Elite::BehaviorState::Failure;
-
-		float deltaTime;
-		if (!pBlackboard->GetData("DeltaTime", deltaTime))
-			return Elite::BehaviorState::Failure;
-
-		// Decrement the enemylook timer with deltatime
-		lookingForEnemyTimer -= deltaTime;
-
-		// Store the enemy look timer
-		pBlackboard->ChangeData("LookForEnemyTimer", lookingForEnemyTimer);
-
-		// If the look enemy timer is equal or less then zero, disable looking for an enemy
-		if (lookingForEnemyTimer <= 0)
-		{
-			pBlackboard->ChangeData("LookingForEnemy", false);
-		}
-
-		return Elite::BehaviorState::Success;
-	}
-
 	// Stand still
 	Elite::BehaviorState StandStill(Elite::Blackboard* pBlackboard)
 	{
@@ -300,28 +219,27 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Inventory", pInventory))
 			return Elite::BehaviorState::Failure;
 
-		EntityInfo curLoot;
-		if (!pBlackboard->GetData("CurLoot", curLoot))
+		static Elite::CachedBlackboardHandle<EntityInfo> curLootHandle{ "CurLoot" };
+		Elite::BlackboardHandle<EntityInfo>& curLootField{ curLootHandle.Bind(pBlackboard) };
+		if (!curLootField)
+			return Elite::BehaviorState::Failure;
+		const EntityInfo& curLoot{ curLootField.View() };
+
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return Elite::BehaviorState::Failure;
 
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return Elite::BehaviorState::Failure;
 		
 		// Try to pick up current loot
 		if (pInventory->PickUpEntity(curLoot))
 		{
-			// Remove the entity from the entity list
-			for (size_t i{}; i < pEntityVec->size(); ++i)
-			{
-				const FoundEntityInfo& entity{ (*pEntityVec)[i] };
-				if (entity.Location.DistanceSquared(curLoot.Location) < 0.2f)
-				{
-					(*pEntityVec)[i] = (*pEntityVec)[pEntityVec->size() - 1];
-					pEntityVec->pop_back();
-					break;
-				}
-			}
+			pHouses->AddFoundItem(curLoot.Location);
+
+			// Forget the item
+			pItemMemory->Remove(curLoot.EntityHash);
 
 			std::cout << "Picked up item\n";
 
@@ -338,32 +256,31 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Inventory", pInventory))
 			return Elite::BehaviorState::Failure;
 
-		EntityInfo curLoot;
-		if (!pBlackboard->GetData("CurLoot", curLoot))
+		static Elite::CachedBlackboardHandle<EntityInfo> curLootHandle{ "CurLoot" };
+		Elite::BlackboardHandle<EntityInfo>& curLootField{ curLootHandle.Bind(pBlackboard) };
+		if (!curLootField)
 			return Elite::BehaviorState::Failure;
+		const EntityInfo& curLoot{ curLootField.View() };
 
 		UINT replaceIndex;
 		if (!pBlackboard->GetData("ReplaceIndex", replaceIndex))
 			return Elite::BehaviorState::Failure;
 
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
+			return Elite::BehaviorState::Failure;
+
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return Elite::BehaviorState::Failure;
 
 		// Try replacing something in the inventory with the current loot
 		if (pInventory->ReplaceItemWithEntity(replaceIndex, curLoot))
 		{
-			// Remove the entity from the entity list
-			for (size_t i{}; i < pEntityVec->size(); ++i)
-			{
-				const FoundEntityInfo& entity{ (*pEntityVec)[i] };
-				if (entity.Location.DistanceSquared(curLoot.Location) < 0.2f)
-				{
-					(*pEntityVec)[i] = (*pEntityVec)[pEntityVec->size() - 1];
-					pEntityVec->pop_back();
-					break;
-				}
-			}
+			pHouses->AddFoundItem(curLoot.Location);
+
+			// Forget the item
+			pItemMemory->Remove(curLoot.EntityHash);
 
 			std::cout << "Picked up item\n";
 
@@ -376,26 +293,27 @@ namespace BT_Actions
 	// Remember the current loot
 	Elite::BehaviorState RememberCurrentLoot(Elite::Blackboard* pBlackboard)
 	{
-		EntityInfo curLoot;
-		if (!pBlackboard->GetData("CurLoot", curLoot))
+		static Elite::CachedBlackboardHandle<EntityInfo> curLootHandle{ "CurLoot" };
+		Elite::BlackboardHandle<EntityInfo>& curLootField{ curLootHandle.Bind(pBlackboard) };
+		if (!curLootField)
 			return Elite::BehaviorState::Failure;
+		const EntityInfo& curLoot{ curLootField.View() };
 
 		IExamInterface* pInterface;
 		if (!pBlackboard->GetData("Interface", pInterface))
 			return Elite::BehaviorState::Failure;
 
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return Elite::BehaviorState::Failure;
 
-		// Loop over already remembered items and if it contains the current item, return
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Location.DistanceSquared(curLoot.Location) < 0.2f)
-			{
-				return Elite::BehaviorState::Failure;
-			}
-		}
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
+			return Elite::BehaviorState::Failure;
+
+		// If the current item is already remembered, return
+		if (pItemMemory->Contains(curLoot.EntityHash))
+			return Elite::BehaviorState::Failure;
 
 		ItemInfo itemInfo;
 		if (!pInterface->Item_GetInfo(curLoot, itemInfo))
@@ -405,22 +323,43 @@ namespace BT_Actions
 		FoundEntityInfo foundEntity{};
 		foundEntity.Location = curLoot.Location;
 		foundEntity.Type = curLoot.Type;
+		foundEntity.EntityHash = curLoot.EntityHash;
 		foundEntity.itemType = itemInfo.Type;
 
-		// Store the found entity in the entity container
-		pEntityVec->push_back(foundEntity);
+		// Store how much the item is worth
+		switch (itemInfo.Type)
+		{
+		case eItemType::PISTOL:
+		case eItemType::SHOTGUN:
+			foundEntity.value = pInterface->Weapon_GetAmmo(itemInfo);
+			break;
+		case eItemType::MEDKIT:
+			foundEntity.value = pInterface->Medkit_GetHealth(itemInfo);
+			break;
+		case eItemType::FOOD:
+			foundEntity.value = pInterface->Food_GetEnergy(itemInfo);
+			break;
+		default:
+			break;
+		}
+
+		// Store the found entity in the item memory
+		pItemMemory->Add(foundEntity);
+		pHouses->AddFoundItem(foundEntity.Location);
 
 		std::cout << "Remembering this item\n";
 
 		return Elite::BehaviorState::Success;
 	}
 
-	// Set the house target to a corner of the house
+	// Set the house target to the next viewpoint of the sweep through the house
 	Elite::BehaviorState SetTargetToCorner(Elite::Blackboard* pBlackboard)
 	{
-		CurrentHouse curHouse;
-		if (!pBlackboard->GetData("CurHouse", curHouse))
+		static Elite::CachedBlackboardHandle<CurrentHouse> curHouseHandle{ "CurHouse" };
+		Elite::BlackboardHandle<CurrentHouse>& curHouseField{ curHouseHandle.Bind(pBlackboard) };
+		if (!curHouseField)
 			return Elite::BehaviorState::Failure;
+		const CurrentHouse& curHouse{ curHouseField.View() };
 
 		Elite::Vector2 target;
 		if (!pBlackboard->GetData("HouseTarget", target))
@@ -434,15 +373,28 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Interface", pInterface))
 			return Elite::BehaviorState::Failure;
 
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
+			return Elite::BehaviorState::Failure;
+
+		SweepPlanner* pSweepPlanner;
+		if (!pBlackboard->GetData("SweepPlanner", pSweepPlanner))
+			return Elite::BehaviorState::Failure;
+
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
 		// Should we change the target
 		bool changeCorner{};
 
 		constexpr float distanceEpsilon{ 2.0f };
-		if (target.DistanceSquared(curHouse.Center) < distanceEpsilon)	// Just entered the house
+		if (!curHouse.isSweeping)	// Just entered the house
 		{
 			changeCorner = true;
+
+			// Start the sweep in the corner closest to the agent, the house is updated in place
+			CurrentHouse& sweptHouse{ curHouseField.Get() };
+			sweptHouse.isSweeping = true;
+			sweptHouse.sweepDirection = pSweepPlanner->GetTourDirection(sweptHouse.Center, sweptHouse.Size, agentInfo.Position);
 		}
 		else if (entityTarget.DistanceSquared(agentInfo.Position) < distanceEpsilon)	// Just picked up an item
 		{
@@ -453,62 +405,33 @@ namespace BT_Actions
 			changeCorner = true;
 
 			// Increment the corneridx
-			++curHouse.curCornerIndex;
-			pBlackboard->ChangeData("CurHouse", curHouse);
+			++curHouseField.Get().curCornerIndex;
+
+			// Remember how far the house is looted
+			const int houseId{ pHouses->Find(curHouse.Center) };
+			if (houseId >= 0) pHouses->GetHouse(houseId).nrCornersVisited = curHouse.curCornerIndex;
 		}
 
 		// If we should not change corner, do nothing
 		if (!changeCorner) return Elite::BehaviorState::Success;
 
-		// The current corner to move to
-		Elite::Vector2 curCorner{};
+		const std::vector<Elite::Vector2>& tour{ pSweepPlanner->GetTour(curHouse.Size) };
 
-		// Set the corner position to the right position
-		switch (curHouse.curCornerIndex)
-		{
-		case 0:
-		{
-			curCorner =
-			{
-				curHouse.Center.x - curHouse.Size.x / 4.0f,
-				curHouse.Center.y + curHouse.Size.y / 4.0f
-			};
-			break;
-		}
-		case 1:
-		{
-			curCorner =
-			{
-				curHouse.Center.x + curHouse.Size.x / 4.0f,
-				curHouse.Center.y - curHouse.Size.y / 4.0f
-			};
-			break;
-		}
-		case 2:
-		{
-			curCorner =
-			{
-				curHouse.Center.x + curHouse.Size.x / 4.0f,
-				curHouse.Center.y + curHouse.Size.y / 4.0f
-			};
-			break;
-		}
-		case 3:
-		{
-			curCorner =
-			{
-				curHouse.Center.x - curHouse.Size.x / 4.0f,
-				curHouse.Center.y - curHouse.Size.y / 4.0f
-			};
-			break;
-		}
-		case 4:
+		// If every viewpoint is visited, the house is looted
+		if (curHouse.curCornerIndex >= static_cast<int>(tour.size()))
 		{
 			std::cout << "Finished looting house\n";
 
 			return Elite::BehaviorState::Failure;
 		}
-		}
+
+		// The current viewpoint to move to
+		const Elite::Vector2& offset{ tour[curHouse.curCornerIndex] };
+		const Elite::Vector2 curCorner
+		{
+			curHouse.Center.x + offset.x * curHouse.sweepDirection.x,
+			curHouse.Center.y + offset.y * curHouse.sweepDirection.y
+		};
 
 		// Store the new corner in the house target
 		pBlackboard->ChangeData("HouseTarget", curCorner);
@@ -523,16 +446,23 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Explorer", pExplorer))
 			return Elite::BehaviorState::Failure;
 
-		CurrentHouse curHouse;
-		if (!pBlackboard->GetData("CurHouse", curHouse))
+		static Elite::CachedBlackboardHandle<CurrentHouse> curHouseHandle{ "CurHouse" };
+		Elite::BlackboardHandle<CurrentHouse>& curHouseField{ curHouseHandle.Bind(pBlackboard) };
+		if (!curHouseField)
 			return Elite::BehaviorState::Failure;
+		const CurrentHouse& curHouse{ curHouseField.View() };
 
-		std::vector<HouseInfo>* pHousesVec;
-		if (!pBlackboard->GetData("HouseAllVec", pHousesVec))
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return Elite::BehaviorState::Failure;
 
-		// Add the current house to the house container
-		pHousesVec->push_back(static_cast<HouseInfo>(curHouse));
+		IExamInterface* pInterface;
+		if (!pBlackboard->GetData("Interface", pInterface))
+			return Elite::BehaviorState::Failure;
+
+		// Add the current house to the known houses and visit it this round
+		const int houseId{ pHouses->Add(static_cast<HouseInfo>(curHouse)) };
+		pHouses->MarkVisited(houseId, pInterface->World_GetStats().TimeSurvived);
 
 		// If the agent is not revisiting buildings, add it the currenthouse as an explore tile
 		if (!pExplorer->IsRevisitingBuildings())
@@ -559,13 +489,33 @@ namespace BT_Actions
 		if (!pBlackboard->GetData("Steering", pSteering))
 			return Elite::BehaviorState::Failure;
 
+		TaskScheduler* pScheduler;
+		if (!pBlackboard->GetData("Scheduler", pScheduler))
+			return Elite::BehaviorState::Failure;
+
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Get the closest undiscovered tile on the grid
-		const Elite::Vector2 checkpointLocation{ pExplorer->GetNearestUndiscoveredGrid(agentInfo.Position) };
+		// Wait for the search of the closest undiscovered tile to finish
+		if (pExplorer->IsSearching()) return Elite::BehaviorState::Running;
+
+		if (!pExplorer->HasTarget())
+		{
+			// If the agent is done exploring, do nothing
+			if (pExplorer->IsDoneExploring()) return Elite::BehaviorState::Failure;
 
-		// If the agent is done exploring, do nothing
-		if (pExplorer->IsDoneExploring()) return Elite::BehaviorState::Failure;
+			// Search for the closest undiscovered tile on the grid, the result arrives in a later frame
+			pExplorer->StartSearch(agentInfo.Position);
+			if (pExplorer->IsSearching())
+			{
+				pScheduler->Submit([pExplorer]() { return pExplorer->StepSearch(); });
+				return Elite::BehaviorState::Running;
+			}
+
+			// Revisiting tiles are found right away
+			if (!pExplorer->HasTarget()) return Elite::BehaviorState::Failure;
+		}
+
+		const Elite::Vector2 checkpointLocation{ pExplorer->GetTarget() };
 
 		// Get the closest point on the nav mesh path
 		const Elite::Vector2 nextTargetPos = pInterface->NavMesh_GetClosestPathPoint(checkpointLocation);
@@ -596,15 +546,8 @@ namespace BT_Actions
 		// Apply the angular velocity to the steering
 		pSteering->Rotate(angularVelocity);
 		
-		// If there is enough stamina, run
-		if (agentInfo.RunMode)
-		{
-			if (agentInfo.Stamina > 2.0f) pSteering->Run();
-		}
-		else
-		{
-			if (agentInfo.Stamina >= 10.0f) pSteering->Run();
-		}
+		// Run when the stamina scheduler thinks it is worth it
+		pSteering->RunTowards(checkpointLocation, agentInfo);
 
 		// Reset the entity and house targets
 		pBlackboard->ChangeData("EntityTarget", Elite::Vector2{});
@@ -617,39 +560,34 @@ namespace BT_Actions
 	// Add all known houses to the world exploration to be revisited
 	Elite::BehaviorState RevisitHouses(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<HouseInfo>* pHouseVec;
-		if (!pBlackboard->GetData("HouseAllVec", pHouseVec))
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return Elite::BehaviorState::Failure;
 
 		WorldExplorer* pExplorer;
 		if (!pBlackboard->GetData("Explorer", pExplorer))
 			return Elite::BehaviorState::Failure;
 
-		// Reset the explorer
-		pExplorer->Reset();
-
-		// Add every house as a revisit tile
-		for (const HouseInfo& house : *pHouseVec)
+		// Reset the explorer and add every house as a revisit tile
+		std::vector<Elite::Vector2> houseCenters{};
+		houseCenters.reserve(pHouses->GetHouses().size());
+		for (const KnownHouse& house : pHouses->GetHouses())
 		{
-			pExplorer->AddRevisitTile(house.Center);
+			houseCenters.push_back(house.info.Center);
 		}
+		pExplorer->StartRevisiting(houseCenters);
 
-		// Clear the house container
-		pHouseVec->clear();
+		// Every house can be looted again
+		pHouses->StartNewRound();
 
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return Elite::BehaviorState::Failure;
 
-		// Remove every item that is a garbage from the remembered item container
-		pEntityVec->erase(
-			std::remove_if(
-				pEntityVec->begin(), 
-				pEntityVec->end(), 
-				[](const FoundEntityInfo& entity) { return entity.itemType == eItemType::GARBAGE; }),
-			pEntityVec->end());
+		// Remove every item that is a garbage from the item memory
+		pItemMemory->RemoveGarbage();
 
-		return Elite::BehaviorState::Success;
+		return Elite::BehaviorState::Running;
 	}
 }
 
@@ -658,8 +596,8 @@ namespace BT_Conditions
 	// Is agent right in front of the agent
 	bool IsEnemyInFront(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		EnemyPredictor* pEnemyPredictor;
+		if (!pBlackboard->GetData("EnemyPredictor", pEnemyPredictor))
 			return false;
 
 		IExamInterface* pInterface;
@@ -668,54 +606,27 @@ namespace BT_Conditions
 
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Calculate the look direction
-		const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
-
-		// The threshold when enemies are in front of the player
-		constexpr float dotThreshold{ 0.002f };
-
-		// For each enemy
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Type == eEntityType::ENEMY)
-			{
-				// Calculate the vector from agent to enemy
-				Elite::Vector2 dir{ entity.Location - agentInfo.Position };
-				dir.Normalize();
-				
-				// If the dot product between the agentEnemyVector and the lookdirection is close to 1, return true
-				if (dir.Dot(lookDir) > 1.0f - dotThreshold) return true;
-			}
-		}
-
-		return false;
+		// If a bullet fired now would pass through an enemy, return true
+		return pEnemyPredictor->IsInLineOfFire(agentInfo, agentInfo.FOV_Range);
 	}
 
 	// Sees enemy?
 	bool IsEnemyInFOV(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		EnemyPredictor* pEnemyPredictor;
+		if (!pBlackboard->GetData("EnemyPredictor", pEnemyPredictor))
 			return false;
 
-		IExamInterface* pInterface;
-		if (!pBlackboard->GetData("Interface", pInterface))
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
 			return false;
 
-		AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
+		// Set the place where the best enemy to shoot will be when the agent faces it as entity target
+		Elite::Vector2 aimPoint{};
+		if (!pEnemyPredictor->SelectTarget(*pAgentInfo, aimPoint)) return false;
 
-		// For each enemy
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Type == eEntityType::ENEMY)
-			{
-				// Set the first enemy as entity target
-				pBlackboard->ChangeData("EntityTarget", entity.Location);
-				return true;
-			}
-		}
-
-		return false;
+		pBlackboard->ChangeData("EntityTarget", aimPoint);
+		return true;
 	}
 
 	// Is the agent looking for an enemy?
@@ -737,18 +648,30 @@ namespace BT_Conditions
 
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
+		EnemyTracker* pEnemyTracker;
+		if (!pBlackboard->GetData("EnemyTracker", pEnemyTracker))
+			return false;
+
 		// If the agent was bitten
 		if (agentInfo.WasBitten)
 		{
 			// Calculate the look direction
 			const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
 
-			pBlackboard->ChangeData("EntityTarget", agentInfo.Position - lookDir);
+			// The biter is probably the closest remembered enemy, otherwise it is behind the agent
+			constexpr float biteRange{ 5.0f };
+			const int nearestThreat{ pEnemyTracker->GetNearestThreat(agentInfo.Position, biteRange) };
+			if (nearestThreat >= 0)
+			{
+				pBlackboard->ChangeData("EntityTarget", pEnemyTracker->GetPredictedPosition(nearestThreat));
+			}
+			else
+			{
+				pBlackboard->ChangeData("EntityTarget", agentInfo.Position - lookDir);
+			}
 
-			// Reset the looking for enemy timer
+			// Start looking for the enemy, LookAround keeps track of the time
 			pBlackboard->ChangeData("LookingForEnemy", true);
-			constexpr float lookAroundTimer{ 2.0f };
-			pBlackboard->ChangeData("LookForEnemyTimer", lookAroundTimer);
 		}
 
 		return agentInfo.WasBitten;
@@ -767,8 +690,8 @@ namespace BT_Conditions
 	// Sees a purge zone right in front of the agent?
 	bool IsPurgeZoneInFront(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return false;
 
 		IExamInterface* pInterface;
@@ -780,36 +703,29 @@ namespace BT_Conditions
 
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Search for the purgezone
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Type == eEntityType::PURGEZONE)
-			{
-				PurgeZoneInfo zoneInfo;
-				pInterface->PurgeZone_GetInfo(entity, zoneInfo);
+		// Only the closest purgezone matters
+		const std::vector<UINT>& purgeZones{ pPerception->GetPurgeZones() };
+		if (purgeZones.empty()) return false;
 
-				// Calculate the vector from center of purgezone to the agent
-				Elite::Vector2 centerPlayer{ agentInfo.Position - zoneInfo.Center };
-				// Get the distance between the player and the purgezone center
-				const float playerDistanceFromZone{ centerPlayer.Normalize() };
-				// Calculate the radius that the agent should stay away from
-				const float runRadius{ zoneInfo.Radius + 4.0f };
+		PurgeZoneInfo zoneInfo;
+		pInterface->PurgeZone_GetInfo(pPerception->GetEntity(purgeZones[0]), zoneInfo);
 
-				// If the agent is outside the runradius, stop the loop
-				if (playerDistanceFromZone > runRadius) break;
-
-				return true;
-			}
-		}
+		// Calculate the vector from center of purgezone to the agent
+		Elite::Vector2 centerPlayer{ agentInfo.Position - zoneInfo.Center };
+		// Get the distance between the player and the purgezone center
+		const float playerDistanceFromZone{ centerPlayer.Normalize() };
+		// Calculate the radius that the agent should stay away from
+		const float runRadius{ zoneInfo.Radius + 4.0f };
 
-		return false;
+		// Is the agent inside the runradius
+		return playerDistanceFromZone <= runRadius;
 	}
 
 	// Is agent inside a purge zone?
 	bool IsInsidePurgeZone(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return false;
 
 		IExamInterface* pInterface;
@@ -821,42 +737,37 @@ namespace BT_Conditions
 		// How close the agent should be to the purge zone return true
 		constexpr float inFrontDistance{ 5.0f };
 
-		// Search for a purge zone
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			if (entity.Type == eEntityType::PURGEZONE)
-			{
-				PurgeZoneInfo zoneInfo;
-				pInterface->PurgeZone_GetInfo(entity, zoneInfo);
+		// Only the closest purge zone matters
+		const std::vector<UINT>& purgeZones{ pPerception->GetPurgeZones() };
+		if (purgeZones.empty()) return false;
 
-				// Calculate the vector from center of purgezone to the agent
-				Elite::Vector2 centerPlayer{ agentInfo.Position - zoneInfo.Center };
-				// Get the distance between the player and the purgezone center
-				const float playerDistanceFromZone{ centerPlayer.Normalize() };
+		PurgeZoneInfo zoneInfo;
+		pInterface->PurgeZone_GetInfo(pPerception->GetEntity(purgeZones[0]), zoneInfo);
 
-				// If the player is outside the radius, stop the loop
-				if (playerDistanceFromZone > zoneInfo.Radius) break;
+		// Calculate the vector from center of purgezone to the agent
+		Elite::Vector2 centerPlayer{ agentInfo.Position - zoneInfo.Center };
+		// Get the distance between the player and the purgezone center
+		const float playerDistanceFromZone{ centerPlayer.Normalize() };
 
-				// Calculate the radius that the agent should stay away from
-				const float runRadius{ zoneInfo.Radius + inFrontDistance };
-				// Calculate the point where to run to
-				const Elite::Vector2 runPoint{ zoneInfo.Center + centerPlayer * runRadius };
+		// If the player is outside the radius, return
+		if (playerDistanceFromZone > zoneInfo.Radius) return false;
 
-				// Apply the runpoint
-				pBlackboard->ChangeData("EntityTarget", runPoint);
+		// Calculate the radius that the agent should stay away from
+		const float runRadius{ zoneInfo.Radius + inFrontDistance };
+		// Calculate the point where to run to
+		const Elite::Vector2 runPoint{ zoneInfo.Center + centerPlayer * runRadius };
 
-				return true;
-			}
-		}
+		// Apply the runpoint
+		pBlackboard->ChangeData("EntityTarget", runPoint);
 
-		return false;
+		return true;
 	}
 
 	// Can pick up loot?
 	bool IsLootInRange(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return false;
 
 		IExamInterface* pInterface;
@@ -865,40 +776,15 @@ namespace BT_Conditions
 
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// Has found loot
-		bool foundLoot{};
-		// The closest food entity
-		EntityInfo closestLoot{};
-		// The closest distance
-		float closestDistance{ FLT_MAX };
-
-		// For each entity
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			// If the entity is not an agent, continue to the next entity
-			if (entity.Type != eEntityType::ITEM) continue;
+		// If the agent does not see loot, return
+		const std::vector<UINT>& items{ pPerception->GetItems() };
+		if (items.empty()) return false;
 
-			// Calculate the distance between entity and agent
-			const float curDistance{ agentInfo.Position.DistanceSquared(entity.Location) };
-
-			// If the current distance is smaller then the current closest distance
-			if (curDistance < closestDistance)
-			{
-				// Store the current entity and distance
-				closestLoot = entity;
-				closestDistance = curDistance;
-				foundLoot = true;
-			}
-		}
-
-		// If the agent does not see food, return
-		if (!foundLoot) return false;
-
-		// Is loot in grab range
-		const bool isLootInRange{ closestDistance < agentInfo.GrabRange * agentInfo.GrabRange };
+		// Is the closest loot in grab range
+		const bool isLootInRange{ pPerception->GetDistanceSquared(items[0]) < agentInfo.GrabRange * agentInfo.GrabRange };
 
 		// If the loot is in grab range, store the current loot
-		if (isLootInRange) pBlackboard->ChangeData("CurLoot", closestLoot);
+		if (isLootInRange) pBlackboard->ChangeData("CurLoot", pPerception->GetEntity(items[0]));
 
 		return isLootInRange;
 	}
@@ -916,19 +802,21 @@ namespace BT_Conditions
 	// Is a better inventory possible with the current item?
 	bool IsBetterInventoryPossible(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return false;
 
 		InventoryManager* pInventory;
 		if (!pBlackboard->GetData("Inventory", pInventory))
 			return false;
 
-		EntityInfo curLoot;
-		if (!pBlackboard->GetData("CurLoot", curLoot))
+		static Elite::CachedBlackboardHandle<EntityInfo> curLootHandle{ "CurLoot" };
+		Elite::BlackboardHandle<EntityInfo>& curLootField{ curLootHandle.Bind(pBlackboard) };
+		if (!curLootField)
 			return false;
+		const EntityInfo& curLoot{ curLootField.View() };
 
-		const UINT indexToReplace{ pInventory->IsBetterInventoryPossible(curLoot, *pEntityVec) };
+		const UINT indexToReplace{ pInventory->IsBetterInventoryPossible(curLoot, pItemMemory->GetItems()) };
 
 		if (indexToReplace != 10) // 10 is error code
 		{
@@ -941,77 +829,55 @@ namespace BT_Conditions
 	// Sees loot?
 	bool IsLootInFov(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return false;
 
-		// For each entity in fov
-		for (const EntityInfo& entity : *pEntityVec)
-		{
-			// If the entity is an item, return true
-			if (entity.Type == eEntityType::ITEM) return true;
-		}
-
-		return false;
+		return !pPerception->GetItems().empty();
 	}
 
 	// Is current loot already seen?
 	bool IsLootAlreadySeen(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<EntityInfo>* pEntityFovVec;
-		if (!pBlackboard->GetData("EntityFovVec", pEntityFovVec))
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
 			return false;
 
-		IExamInterface* pInterface;
-		if (!pBlackboard->GetData("Interface", pInterface))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return false;
 
-		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-
-		// Sort all the entities in fov by distance from agent
-		std::sort(
-			pEntityFovVec->begin(),
-			pEntityFovVec->end(),
-			[&](const EntityInfo& first, const EntityInfo& second) 
-			{
-				const float firstDist{ first.Location.DistanceSquared(agentInfo.Position) };
-				const float secondDist{ second.Location.DistanceSquared(agentInfo.Position) };
-
-				return firstDist < secondDist;
-			}
-		);
-
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
-			return false;
+		// The closest item that is not remembered yet
+		const EntityInfo* pClosestEntity{};
+		float closestDistance{ FLT_MAX };
 
-		// For each entity in fov
-		for (const EntityInfo& fovEntity : *pEntityFovVec)
+		// For each item in fov, closest first
+		const std::vector<UINT>& items{ pPerception->GetItems() };
+		const size_t nrSorted{ pPerception->GetNrSorted(items) };
+		for (size_t i{}; i < items.size(); ++i)
 		{
-			// If the entity is not an item, continue to the next entity
-			if (fovEntity.Type != eEntityType::ITEM) continue;
+			const EntityInfo& fovEntity{ pPerception->GetEntity(items[i]) };
 
-			bool alreadySeen{};
-			// For each remembered item
-			for (const FoundEntityInfo& entity : *pEntityVec)
-			{
-				// If the locations of the items overlap, set already seen to true
-				if (fovEntity.Location.DistanceSquared(entity.Location) < 0.2f)
-				{
-					alreadySeen = true;
-					break;
-				}
-			}
+			// If the item is further away than the closest item, continue to the next entity
+			const float distance{ pPerception->GetDistanceSquared(items[i]) };
+			if (distance >= closestDistance) continue;
 
-			// If the item is already seen, continue to the next item
-			if (alreadySeen) continue;
+			// If the item is already remembered, continue to the next item
+			if (pItemMemory->Contains(fovEntity.EntityHash)) continue;
 
-			// Store the item in entity target
-			pBlackboard->ChangeData("EntityTarget", fovEntity.Location);
-			return false;
+			pClosestEntity = &fovEntity;
+			closestDistance = distance;
+
+			// The sorted items come first, so the first new one among them is the closest
+			if (i < nrSorted) break;
 		}
 
-		return true;
+		// If every item is already seen, return true
+		if (!pClosestEntity) return true;
+
+		// Store the item in entity target
+		pBlackboard->ChangeData("EntityTarget", pClosestEntity->Location);
+		return false;
 	}
 
 	// Sees house?
@@ -1021,27 +887,15 @@ namespace BT_Conditions
 		if (!pBlackboard->GetData("HouseFovVec", pHouseVec))
 			return false;
 
-		std::vector<HouseInfo>* pSeenHousesVec;
-		if (!pBlackboard->GetData("HouseAllVec", pSeenHousesVec))
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return false;
 
 		// For each house in fov
 		for (const HouseInfo& house : *pHouseVec)
 		{
-			bool newHouse{ true };
-
-			// For each already seen house
-			for (const HouseInfo& visitedHouse : *pSeenHousesVec)
-			{
-				// If the locations of the houses match, set new house to false
-				if (house.Center.DistanceSquared(visitedHouse.Center) < 0.2f)
-				{
-					newHouse = false;
-				}
-			}
-
-			// If the current house is not a new house, continue to the next house
-			if (!newHouse) continue;
+			// If the current house was already visited this round, continue to the next house
+			if (pHouses->IsVisited(pHouses->Find(house.Center))) continue;
 
 			// Create a new currenthouse object
 			CurrentHouse newHouseInfo{};
@@ -1064,28 +918,29 @@ namespace BT_Conditions
 	// Is Moving Towards A House?
 	bool IsMovingTowardsHouse(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<HouseInfo>* pHouseVec;
-		if (!pBlackboard->GetData("HouseAllVec", pHouseVec))
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return false;
 
 		Elite::Vector2 target;
 		if (!pBlackboard->GetData("HouseTarget", target))
 			return false;
 
-		// For each house in memory
-		for (const HouseInfo& house : *pHouseVec)
-		{
-			// If the target matches the location of a house, return true
-			if (house.Center.DistanceSquared(target) < 2.0f) return true;
-		}
+		// If the target is a house that is visited this round, return true
+		if (pHouses->IsVisited(pHouses->Find(target))) return true;
 
+		static Elite::CachedBlackboardHandle<CurrentHouse> curHouseHandle{ "CurHouse" };
+		Elite::BlackboardHandle<CurrentHouse>& curHouseField{ curHouseHandle.Bind(pBlackboard) };
+		if (!curHouseField)
+			return false;
+		const CurrentHouse& curHouse{ curHouseField.View() };
 
-		CurrentHouse curHouse;
-		if (!pBlackboard->GetData("CurHouse", curHouse))
+		SweepPlanner* pSweepPlanner;
+		if (!pBlackboard->GetData("SweepPlanner", pSweepPlanner))
 			return false;
 
-		// If the current house has a valid size and the corneridx is less then 4, we are still looting a house
-		if (curHouse.Size.x > FLT_EPSILON && curHouse.curCornerIndex < 4) return true;
+		// If the current house has a valid size and not every viewpoint is visited, we are still looting a house
+		if (curHouse.Size.x > FLT_EPSILON && curHouse.curCornerIndex < static_cast<int>(pSweepPlanner->GetTour(curHouse.Size).size())) return true;
 
 		return false;
 	}
@@ -1097,8 +952,14 @@ namespace BT_Conditions
 		if (!pBlackboard->GetData("Interface", pInterface))
 			return false;
 
-		CurrentHouse curHouse{};
-		if (!pBlackboard->GetData("CurHouse", curHouse))
+		static Elite::CachedBlackboardHandle<CurrentHouse> curHouseHandle{ "CurHouse" };
+		Elite::BlackboardHandle<CurrentHouse>& curHouseField{ curHouseHandle.Bind(pBlackboard) };
+		if (!curHouseField)
+			return false;
+		const CurrentHouse& curHouse{ curHouseField.View() };
+
+		HouseRegistry* pHouses;
+		if (!pBlackboard->GetData("Houses", pHouses))
 			return false;
 
 		// If the size of the current house is not valid, return false
@@ -1106,23 +967,16 @@ namespace BT_Conditions
 
 		const AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
 
-		// If the agent is inside the bounds of a house, return true
-		if (agentInfo.Position.x > curHouse.Center.x - curHouse.Size.x / 2 &&
-			agentInfo.Position.x < curHouse.Center.x + curHouse.Size.x / 2 &&
-			agentInfo.Position.y > curHouse.Center.y - curHouse.Size.y / 2 &&
-			agentInfo.Position.y < curHouse.Center.y + curHouse.Size.y / 2)
-		{
-			return true;
-		}
-
-		return false;
+		// If the agent stands in the current house, return true
+		const int houseId{ pHouses->GetHouseAt(agentInfo.Position) };
+		return houseId >= 0 && houseId == pHouses->Find(curHouse.Center);
 	}
 
 	// Does the agent remember a needed item?
 	bool RemembersNeededItem(Elite::Blackboard* pBlackboard)
 	{
-		std::vector<FoundEntityInfo>* pEntityVec;
-		if (!pBlackboard->GetData("EntityAllVec", pEntityVec))
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
 			return false;
 
 		IExamInterface* pInterface;
@@ -1135,52 +989,541 @@ namespace BT_Conditions
 		if (!pBlackboard->GetData("Inventory", pInventory))
 			return false;
 
+		LootTourPlanner* pLootTour;
+		if (!pBlackboard->GetData("LootTour", pLootTour))
+			return false;
+
+		FrameArena* pFrameArena;
+		if (!pBlackboard->GetData("FrameArena", pFrameArena))
+			return false;
+
 		constexpr float rangeToLook{ 250.0f };
 
-		pInterface->Draw_Circle(agentInfo.Position, rangeToLook, { 0.0f, 0.0f, 1.0f });
+		// Collect every missing item type, most needed first
+		FrameVector<eItemType> neededItems{ FrameAllocator<eItemType>{ pFrameArena } };
+		if (!pInventory->HasFood()) neededItems.push_back(eItemType::FOOD);
+		if (!pInventory->HasMedkit()) neededItems.push_back(eItemType::MEDKIT);
+		if (!pInventory->HasPistol()) neededItems.push_back(eItemType::PISTOL);
+		if (!pInventory->HasShotgun()) neededItems.push_back(eItemType::SHOTGUN);
 
-		// Set the needed item to the most needed item
-		eItemType neededItem{ eItemType::RANDOM_DROP };
-		if (!pInventory->HasFood()) neededItem = eItemType::FOOD;
-		else if (!pInventory->HasMedkit()) neededItem = eItemType::MEDKIT;
-		else if (!pInventory->HasPistol()) neededItem = eItemType::PISTOL;
-		else if (!pInventory->HasShotgun()) neededItem = eItemType::SHOTGUN;
+		// Plan one route past all of them
+		pLootTour->Update(agentInfo.Position, *pItemMemory, neededItems, rangeToLook);
 
-		// If no item is needed, return false
-		if (neededItem == eItemType::RANDOM_DROP) return false;
+		// If no needed item is remembered, return false
+		if (pLootTour->IsEmpty()) return false;
 
-		int curItem{ -1 };
-		float closestDistance{ FLT_MAX };
+		// Store the first stop of the route in the entity target
+		pBlackboard->ChangeData("EntityTarget", pLootTour->GetNextStop());
+		return true;
+	}
+}
+
+namespace BT_Routines
+{
+	// Look around for the enemy that bit the agent, while backing off from it
+	// Only rotate when a purge zone is in front, backing off could walk into it
+	Elite::BehaviorRoutine LookAround(Elite::BehaviorRoutinePool&, Elite::Blackboard* pBlackboard)
+	{
+		Steering* pSteering;
+		if (!pBlackboard->GetData("Steering", pSteering))
+			co_return Elite::BehaviorState::Failure;
+
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			co_return Elite::BehaviorState::Failure;
+
+		EnemyTracker* pEnemyTracker;
+		if (!pBlackboard->GetData("EnemyTracker", pEnemyTracker))
+			co_return Elite::BehaviorState::Failure;
+
+		// These fields change every frame, they are looked up once for the whole routine
+		Elite::BlackboardHandle<Elite::Vector2> entityTargetField{ pBlackboard->Bind<Elite::Vector2>("EntityTarget") };
+		Elite::BlackboardHandle<float> deltaTimeField{ pBlackboard->Bind<float>("DeltaTime") };
+		if (!entityTargetField || !deltaTimeField)
+			co_return Elite::BehaviorState::Failure;
+
+		// The time left to look around is part of the routine
+		constexpr float lookAroundTime{ 2.0f };
+		float timeLeft{ lookAroundTime };
+
+		while (true)
+		{
+			const AgentInfo& agentInfo{ *pAgentInfo };
+
+			// Every new bite starts the look around over
+			if (agentInfo.WasBitten) timeLeft = lookAroundTime;
+
+			Elite::Vector2 target{ entityTargetField.View() };
+
+			if (BT_Conditions::IsPurgeZoneInFront(pBlackboard))
+			{
+				// Force the agent to rotate
+				pSteering->Rotate(agentInfo.MaxAngularSpeed);
+			}
+			else
+			{
+				// Turn to where a close remembered enemy should be, otherwise force the agent to rotate
+				constexpr float biteRange{ 5.0f };
+				const int nearestThreat{ pEnemyTracker->GetNearestThreat(agentInfo.Position, biteRange) };
+				if (nearestThreat >= 0 && !pEnemyTracker->IsVisible(nearestThreat))
+				{
+					target = pEnemyTracker->GetPredictedPosition(nearestThreat);
+					pSteering->LookAt(target);
+				}
+				else
+				{
+					pSteering->Rotate(agentInfo.MaxAngularSpeed);
+				}
+				// Flee from target
+				pSteering->AddFlee(target, agentInfo);
+			}
+
+			timeLeft -= deltaTimeField.View();
+			if (timeLeft <= 0.0f) break;
+
+			co_yield Elite::BehaviorState::Running;
+		}
+
+		// Done looking for the enemy
+		pBlackboard->ChangeData("LookingForEnemy", false);
+		co_return Elite::BehaviorState::Success;
+	}
+}
+
+namespace UT_Considerations
+{
+	// Considerations only read the data of the current frame, they never change the blackboard
+
+	// Is an enemy right in front of the agent? (0 or 1)
+	float EnemyInFront(Elite::Blackboard* pBlackboard)
+	{
+		return BT_Conditions::IsEnemyInFront(pBlackboard) ? 1.0f : 0.0f;
+	}
+
+	// Number of enemies in fov
+	float NrEnemiesInFOV(Elite::Blackboard* pBlackboard)
+	{
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
+			return 0.0f;
+
+		return static_cast<float>(pPerception->GetEnemies().size());
+	}
+
+	// Has the agent a gun? (0 or 1)
+	float HasGun(Elite::Blackboard* pBlackboard)
+	{
+		return BT_Conditions::IsGunInInventory(pBlackboard) ? 1.0f : 0.0f;
+	}
+
+	// Is the agent looking for an enemy or was it just bitten? (0 or 1)
+	float IsAlerted(Elite::Blackboard* pBlackboard)
+	{
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return 0.0f;
+
+		return BT_Conditions::IsLookingForEnemy(pBlackboard) || pAgentInfo->WasBitten ? 1.0f : 0.0f;
+	}
+
+	// Is there a purge zone in fov? (0 or 1)
+	float PurgeZoneInFOV(Elite::Blackboard* pBlackboard)
+	{
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
+			return 0.0f;
+
+		return pPerception->GetPurgeZones().empty() ? 0.0f : 1.0f;
+	}
+
+	// Is there loot in fov? (0 or 1)
+	float LootInFOV(Elite::Blackboard* pBlackboard)
+	{
+		return BT_Conditions::IsLootInFov(pBlackboard) ? 1.0f : 0.0f;
+	}
+
+	// Is any loot in grab range? (0 or 1)
+	float LootInGrabRange(Elite::Blackboard* pBlackboard)
+	{
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
+			return 0.0f;
+
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return 0.0f;
+
+		// Only the closest item has to be checked
+		const std::vector<UINT>& items{ pPerception->GetItems() };
+		const float grabRangeSqr{ pAgentInfo->GrabRange * pAgentInfo->GrabRange };
+		return !items.empty() && pPerception->GetDistanceSquared(items[0]) < grabRangeSqr ? 1.0f : 0.0f;
+	}
+
+	// Is the agent inside the house it is looting? (0 or 1)
+	float InsideHouse(Elite::Blackboard* pBlackboard)
+	{
+		return BT_Conditions::IsInsideHouse(pBlackboard) ? 1.0f : 0.0f;
+	}
+
+	// Is the agent on its way to a house? (0 or 1)
+	float MovingTowardsHouse(Elite::Blackboard* pBlackboard)
+	{
+		return BT_Conditions::IsMovingTowardsHouse(pBlackboard) ? 1.0f : 0.0f;
+	}
+
+	// Is there a house in fov? (0 or 1)
+	float HouseInFOV(Elite::Blackboard* pBlackboard)
+	{
+		std::vector<HouseInfo>* pHouseVec;
+		if (!pBlackboard->GetData("HouseFovVec", pHouseVec))
+			return 0.0f;
+
+		return pHouseVec->empty() ? 0.0f : 1.0f;
+	}
 
-		// For each remembered item
-		for (size_t i{}; i < pEntityVec->size(); ++i)
+	// How many of the wanted item types are missing from the inventory (0 - 1)
+	float ItemNeed(Elite::Blackboard* pBlackboard)
+	{
+		InventoryManager* pInventory;
+		if (!pBlackboard->GetData("Inventory", pInventory))
+			return 0.0f;
+
+		float nrMissing{};
+		if (!pInventory->HasFood()) ++nrMissing;
+		if (!pInventory->HasMedkit()) ++nrMissing;
+		if (!pInventory->HasPistol()) ++nrMissing;
+		if (!pInventory->HasShotgun()) ++nrMissing;
+
+		return nrMissing / 4.0f;
+	}
+
+	// Energy of the agent (0 - 1)
+	float Energy(Elite::Blackboard* pBlackboard)
+	{
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return 0.0f;
+
+		constexpr float maxEnergy{ 10.0f };
+		return pAgentInfo->Energy / maxEnergy;
+	}
+}
+
+namespace GOAP_Facts
+{
+	// Facts are the bits of the GOAP world state, they never change the blackboard
+
+	// Pistols and shotguns both count as a gun
+	bool IsItemOfType(eItemType itemType, eItemType wantedType)
+	{
+		if (wantedType == eItemType::PISTOL) return itemType == eItemType::PISTOL || itemType == eItemType::SHOTGUN;
+		return itemType == wantedType;
+	}
+
+	// Has the agent an item of this type in its inventory?
+	bool HasItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		InventoryManager* pInventory;
+		if (!pBlackboard->GetData("Inventory", pInventory))
+			return false;
+
+		switch (itemType)
+		{
+		case eItemType::FOOD:
+			return pInventory->HasFood();
+		case eItemType::MEDKIT:
+			return pInventory->HasMedkit();
+		case eItemType::PISTOL:
+			return pInventory->HasPistol() || pInventory->HasShotgun();
+		default:
+			return false;
+		}
+	}
+
+	// Does the agent remember where an item of this type lies?
+	bool RemembersItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
+			return false;
+
+		for (const FoundEntityInfo& entity : pItemMemory->GetItems())
+		{
+			if (IsItemOfType(entity.itemType, itemType)) return true;
+		}
+
+		return false;
+	}
+
+	// Is a remembered item of this type in grab range?
+	bool IsAtItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
+			return false;
+
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return false;
+
+		const float grabRangeSqr{ pAgentInfo->GrabRange * pAgentInfo->GrabRange };
+		for (const FoundEntityInfo& entity : pItemMemory->GetItems())
 		{
-			// Get the current entity
-			const FoundEntityInfo& entity{ (*pEntityVec)[i] };
+			if (IsItemOfType(entity.itemType, itemType) && pAgentInfo->Position.DistanceSquared(entity.Location) < grabRangeSqr) return true;
+		}
 
-			if (entity.itemType != neededItem) continue;
+		return false;
+	}
+
+	// Is the energy of the agent running low?
+	bool IsEnergyLow(Elite::Blackboard* pBlackboard)
+	{
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return false;
+
+		constexpr float lowEnergy{ 5.0f };
+		return pAgentInfo->Energy < lowEnergy;
+	}
 
-			// Calculate the distance between the agent and the entity
-			const float distanceFromItem{ agentInfo.Position.DistanceSquared(entity.Location) };
+	// Is the health of the agent running low?
+	bool IsHealthLow(Elite::Blackboard* pBlackboard)
+	{
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return false;
 
-			// If the item is not food, check if the item is inside the range
-			if (entity.itemType != eItemType::FOOD && distanceFromItem > rangeToLook * rangeToLook) continue;
+		constexpr float lowHealth{ 5.0f };
+		return pAgentInfo->Health < lowHealth;
+	}
 
-			// If the current distance is smaller then the currest smallest distance
-			if (distanceFromItem < closestDistance)
+	// Is the inventory full?
+	bool IsInventoryFull(Elite::Blackboard* pBlackboard)
+	{
+		InventoryManager* pInventory;
+		if (!pBlackboard->GetData("Inventory", pInventory))
+			return false;
+
+		return pInventory->IsInventoryFull();
+	}
+}
+
+namespace GOAP_Actions
+{
+	// Walk to the closest remembered item of this type, succeeds once it is in grab range
+	Elite::BehaviorState GoToRememberedItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
+			return Elite::BehaviorState::Failure;
+
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return Elite::BehaviorState::Failure;
+
+		// Find the closest remembered item
+		const FoundEntityInfo* pClosestEntity{};
+		float closestDistance{ FLT_MAX };
+		for (const FoundEntityInfo& entity : pItemMemory->GetItems())
+		{
+			if (!GOAP_Facts::IsItemOfType(entity.itemType, itemType)) continue;
+
+			const float distance{ pAgentInfo->Position.DistanceSquared(entity.Location) };
+			if (distance < closestDistance)
 			{
-				// Store the current item and distance
-				closestDistance = distanceFromItem;
-				curItem = static_cast<int>(i);
+				closestDistance = distance;
+				pClosestEntity = &entity;
 			}
 		}
 
-		// If no item has been found, return false
-		if (curItem < 0) return false;
+		// The item is gone, the plan has to change
+		if (!pClosestEntity) return Elite::BehaviorState::Failure;
 
-		// Store the item location in the entity target
-		pBlackboard->ChangeData("EntityTarget", (*pEntityVec)[curItem].Location);
-		return true;
+		if (closestDistance < pAgentInfo->GrabRange * pAgentInfo->GrabRange) return Elite::BehaviorState::Success;
+
+		// Keep walking
+		pBlackboard->ChangeData("EntityTarget", pClosestEntity->Location);
+		if (BT_Actions::AddToEntitySeek(pBlackboard) == Elite::BehaviorState::Failure) return Elite::BehaviorState::Failure;
+
+		return Elite::BehaviorState::Running;
+	}
+
+	// Pick up a remembered item of this type that is in grab range
+	Elite::BehaviorState PickUpRememberedItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		Perception* pPerception;
+		if (!pBlackboard->GetData("Perception", pPerception))
+			return Elite::BehaviorState::Failure;
+
+		ItemMemory* pItemMemory;
+		if (!pBlackboard->GetData("ItemMemory", pItemMemory))
+			return Elite::BehaviorState::Failure;
+
+		AgentInfo* pAgentInfo;
+		if (!pBlackboard->GetData("AgentInfo", pAgentInfo))
+			return Elite::BehaviorState::Failure;
+
+		const float grabRangeSqr{ pAgentInfo->GrabRange * pAgentInfo->GrabRange };
+
+		// For each remembered item in grab range
+		for (const FoundEntityInfo& entity : pItemMemory->GetItems())
+		{
+			if (!GOAP_Facts::IsItemOfType(entity.itemType, itemType)) continue;
+			if (pAgentInfo->Position.DistanceSquared(entity.Location) >= grabRangeSqr) continue;
+
+			// Only items in fov can be grabbed
+			for (UINT index : pPerception->GetItems())
+			{
+				const EntityInfo& fovEntity{ pPerception->GetEntity(index) };
+				if (fovEntity.EntityHash != entity.EntityHash) continue;
+
+				// PickUpLoot also forgets the item
+				pBlackboard->ChangeData("CurLoot", fovEntity);
+				return BT_Actions::PickUpLoot(pBlackboard);
+			}
+
+			// Turn towards the item until it is in fov
+			Steering* pSteering;
+			if (!pBlackboard->GetData("Steering", pSteering))
+				return Elite::BehaviorState::Failure;
+
+			pSteering->LookAt(entity.Location);
+			return Elite::BehaviorState::Running;
+		}
+
+		return Elite::BehaviorState::Failure;
+	}
+
+	// Use an item of this type from the inventory
+	Elite::BehaviorState UseItem(Elite::Blackboard* pBlackboard, eItemType itemType)
+	{
+		InventoryManager* pInventory;
+		if (!pBlackboard->GetData("Inventory", pInventory))
+			return Elite::BehaviorState::Failure;
+
+		if (!pInventory->UseItem(itemType)) return Elite::BehaviorState::Failure;
+
+		return Elite::BehaviorState::Success;
+	}
+}
+
+namespace BT_Trees
+{
+	using namespace Elite::Static;
+
+	// The built-in tree of the agent, compiled into direct calls
+	// BehaviorTree.txt holds the same tree for the runtime loader
+	using Combat = Selector<
+		// Try to shoot enemies
+		Sequence<
+			Cond<BT_Conditions::IsEnemyInFront>,
+			Cond<BT_Conditions::IsGunInInventory>,
+			Act<BT_Actions::Shoot>>,
+		// Try to spot enemies
+		Sequence<
+			Cond<BT_Conditions::IsEnemyInFOV>,
+			Cond<BT_Conditions::IsGunInInventory>,
+			Act<BT_Actions::AddToFleeAndLookAt>,
+			Cond<BT_Conditions::IsInsidePurgeZone>,
+			Act<BT_Actions::AddToEntitySeek>>,
+		// Try to look at enemies
+		Sequence<
+			Selector<
+				Cond<BT_Conditions::IsLookingForEnemy>,
+				Cond<BT_Conditions::IsHitByEnemy>>,
+			Cond<BT_Conditions::IsGunInInventory>,
+			Invertor<Cond<BT_Conditions::IsInsidePurgeZone>>,
+			Routine<BT_Routines::LookAround>>,
+		// Try to avoid purge zones
+		Sequence<
+			Cond<BT_Conditions::IsPurgeZoneInFront>,
+			Selector<
+				Sequence<
+					Cond<BT_Conditions::IsInsidePurgeZone>,
+					Act<BT_Actions::AddToEntitySeek>,
+					Act<BT_Actions::LookAtPurgeZone>>,
+				Act<BT_Actions::StandStill>>>>;
+
+	using Search = Selector<
+		// Try to pick up loot
+		Sequence<
+			Cond<BT_Conditions::IsLootInRange>,
+			Selector<
+				Sequence<
+					Cond<BT_Conditions::IsInventoryNotFull>,
+					Act<BT_Actions::PickUpLoot>>,
+				Sequence<
+					Cond<BT_Conditions::IsBetterInventoryPossible>,
+					Act<BT_Actions::PickUpLootAndRearrangeInventory>>,
+				Act<BT_Actions::RememberCurrentLoot>>>,
+		// Try to spot loot
+		Sequence<
+			Cond<BT_Conditions::IsLootInFov>,
+			Invertor<Cond<BT_Conditions::IsLootAlreadySeen>>,
+			Act<BT_Actions::AddToEntitySeek>>,
+		// Move around the building in search of loot
+		Sequence<
+			Cond<BT_Conditions::IsInsideHouse>,
+			Act<BT_Actions::SetTargetToCorner>,
+			Act<BT_Actions::AddToHouseSeek>>,
+		// Try moving to house
+		Sequence<
+			Cond<BT_Conditions::IsMovingTowardsHouse>,
+			Act<BT_Actions::AddToHouseSeek>>,
+		// Try to spot houses
+		Sequence<
+			Cond<BT_Conditions::IsNewHouseInFOV>,
+			Sequence<
+				Act<BT_Actions::AddToHouseSeek>,
+				Act<BT_Actions::AddHouse>>>,
+		// Fill inventory with known items
+		Sequence<
+			Cond<BT_Conditions::RemembersNeededItem>,
+			Act<BT_Actions::AddToEntitySeek>>,
+		// Fall back to world exploration
+		Act<BT_Actions::Explore>,
+		Act<BT_Actions::RevisitHouses>>;
+
+	using Default = Selector<Combat, Search>;
+}
+
+namespace BT_Registry
+{
+	// Make every action, condition and routine available to behavior tree files
+	void RegisterBehaviors(BehaviorTreeLoader& loader)
+	{
+		loader.RegisterAction("AddToFleeAndLookAt", BT_Actions::AddToFleeAndLookAt);
+		loader.RegisterAction("AddToEntitySeek", BT_Actions::AddToEntitySeek);
+		loader.RegisterAction("AddToHouseSeek", BT_Actions::AddToHouseSeek);
+		loader.RegisterAction("LookAtPurgeZone", BT_Actions::LookAtPurgeZone);
+		loader.RegisterAction("Shoot", BT_Actions::Shoot);
+		loader.RegisterAction("StandStill", BT_Actions::StandStill);
+		loader.RegisterAction("PickUpLoot", BT_Actions::PickUpLoot);
+		loader.RegisterAction("PickUpLootAndRearrangeInventory", BT_Actions::PickUpLootAndRearrangeInventory);
+		loader.RegisterAction("RememberCurrentLoot", BT_Actions::RememberCurrentLoot);
+		loader.RegisterAction("SetTargetToCorner", BT_Actions::SetTargetToCorner);
+		loader.RegisterAction("AddHouse", BT_Actions::AddHouse);
+		loader.RegisterAction("Explore", BT_Actions::Explore);
+		loader.RegisterAction("RevisitHouses", BT_Actions::RevisitHouses);
+
+		loader.RegisterConditional("IsEnemyInFront", BT_Conditions::IsEnemyInFront);
+		loader.RegisterConditional("IsEnemyInFOV", BT_Conditions::IsEnemyInFOV);
+		loader.RegisterConditional("IsLookingForEnemy", BT_Conditions::IsLookingForEnemy);
+		loader.RegisterConditional("IsHitByEnemy", BT_Conditions::IsHitByEnemy);
+		loader.RegisterConditional("IsGunInInventory", BT_Conditions::IsGunInInventory);
+		loader.RegisterConditional("IsPurgeZoneInFront", BT_Conditions::IsPurgeZoneInFront);
+		loader.RegisterConditional("IsInsidePurgeZone", BT_Conditions::IsInsidePurgeZone);
+		loader.RegisterConditional("IsLootInRange", BT_Conditions::IsLootInRange);
+		loader.RegisterConditional("IsInventoryNotFull", BT_Conditions::IsInventoryNotFull);
+		loader.RegisterConditional("IsBetterInventoryPossible", BT_Conditions::IsBetterInventoryPossible);
+		loader.RegisterConditional("IsLootInFov", BT_Conditions::IsLootInFov);
+		loader.RegisterConditional("IsLootAlreadySeen", BT_Conditions::IsLootAlreadySeen);
+		loader.RegisterConditional("IsNewHouseInFOV", BT_Conditions::IsNewHouseInFOV);
+		loader.RegisterConditional("IsMovingTowardsHouse", BT_Conditions::IsMovingTowardsHouse);
+		loader.RegisterConditional("IsInsideHouse", BT_Conditions::IsInsideHouse);
+		loader.RegisterConditional("RemembersNeededItem", BT_Conditions::RemembersNeededItem);
+
+		loader.RegisterRoutine("LookAround", BT_Routines::LookAround);
 	}
 }
 
@@ -0,0 +1,259 @@
+#include "../stdafx.h"
+#include <chrono>
+#include <IExamPlugin.h>
+#include "HeadlessInterface.h"
+#include "../Plugin.h"
+
+namespace
+{
+	// Allocations are only counted while the plugin updates
+	bool g_IsCountingAllocations{};
+	size_t g_NrAllocations{};
+
+	struct RunSettings
+	{
+		DecisionMakingType decisionMakingType;
+		std::string levelFile;
+		unsigned int seed;
+		int nrEnemies;
+	};
+
+	struct RunResult
+	{
+		RunSettings settings;
+		int nrTicks;
+		double meanMicroseconds;
+		double p50Microseconds;
+		double p99Microseconds;
+		double maxMicroseconds;
+		double allocationsPerTick;
+		float timeSurvived;
+		int nrItemsPickedUp;
+		int nrEnemiesKilled;
+		int nrEnemiesHit;
+		int nrMissedShots;
+	};
+
+	constexpr float deltaTime{ 1.0f / 60.0f };
+	constexpr int nrItems{ 40 };
+
+	const char* GetDecisionMakingName(DecisionMakingType decisionMakingType)
+	{
+		switch (decisionMakingType)
+		{
+		case DecisionMakingType::BehaviorTree: return "tree";
+		case DecisionMakingType::Utility: return "utility";
+		case DecisionMakingType::GOAP: return "goap";
+		}
+		return "unknown";
+	}
+
+	RunResult Run(const LevelFile& level, const RunSettings& settings, int maxTicks)
+	{
+		// The plugin uses rand(), seed it the same way for every run
+		srand(settings.seed);
+
+		HeadlessInterface world{ level, settings.seed, settings.nrEnemies, nrItems };
+
+		IExamPlugin* pPlugin{ new Plugin{ settings.decisionMakingType } };
+		PluginInfo info{};
+		pPlugin->DllInit();
+		pPlugin->Initialize(&world, info);
+
+		std::vector<double> frameTimes{};
+		frameTimes.reserve(maxTicks);
+		size_t nrAllocations{};
+
+		for (int tick{}; tick < maxTicks && !world.IsAgentDead(); ++tick)
+		{
+			g_NrAllocations = 0;
+			g_IsCountingAllocations = true;
+			const auto start{ std::chrono::high_resolution_clock::now() };
+
+			const SteeringPlugin_Output steering{ pPlugin->UpdateSteering(deltaTime) };
+
+			const auto end{ std::chrono::high_resolution_clock::now() };
+			g_IsCountingAllocations = false;
+			nrAllocations += g_NrAllocations;
+
+			frameTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+			world.Step(steering, deltaTime);
+		}
+
+		pPlugin->DllShutdown();
+		delete pPlugin;
+
+		RunResult result{};
+		result.settings = settings;
+		result.nrTicks = static_cast<int>(frameTimes.size());
+
+		const StatisticsInfo stats{ world.World_GetStats() };
+		result.timeSurvived = stats.TimeSurvived;
+		result.nrItemsPickedUp = stats.NumItemsPickUp;
+		result.nrEnemiesKilled = stats.NumEnemiesKilled;
+		result.nrEnemiesHit = stats.NumEnemiesHit;
+		result.nrMissedShots = stats.NumMissedShots;
+
+		if (frameTimes.empty()) return result;
+
+		double totalTime{};
+		for (double frameTime : frameTimes)
+		{
+			totalTime += frameTime;
+		}
+		result.meanMicroseconds = totalTime / frameTimes.size();
+		result.allocationsPerTick = static_cast<double>(nrAllocations) / frameTimes.size();
+
+		std::sort(frameTimes.begin(), frameTimes.end());
+		result.p50Microseconds = frameTimes[frameTimes.size() / 2];
+		result.p99Microseconds = frameTimes[std::min(frameTimes.size() - 1, frameTimes.size() * 99 / 100)];
+		result.maxMicroseconds = frameTimes.back();
+
+		return result;
+	}
+
+	void WriteResults(const std::string& filePath, const std::vector<RunResult>& results)
+	{
+		std::ofstream file{ filePath };
+		if (!file)
+		{
+			std::cout << "Could not write " << filePath << "\n";
+			return;
+		}
+
+		file << "[\n";
+		for (size_t i{}; i < results.size(); ++i)
+		{
+			const RunResult& result{ results[i] };
+			file << "\t{ \"decisionMaking\": \"" << GetDecisionMakingName(result.settings.decisionMakingType) << "\""
+				<< ", \"level\": \"" << result.settings.levelFile << "\""
+				<< ", \"seed\": " << result.settings.seed
+				<< ", \"enemies\": " << result.settings.nrEnemies
+				<< ", \"ticks\": " << result.nrTicks
+				<< ", \"meanUs\": " << result.meanMicroseconds
+				<< ", \"p50Us\": " << result.p50Microseconds
+				<< ", \"p99Us\": " << result.p99Microseconds
+				<< ", \"maxUs\": " << result.maxMicroseconds
+				<< ", \"allocationsPerTick\": " << result.allocationsPerTick
+				<< ", \"timeSurvived\": " << result.timeSurvived
+				<< ", \"itemsPickedUp\": " << result.nrItemsPickedUp
+				<< ", \"enemiesKilled\": " << result.nrEnemiesKilled
+				<< ", \"enemiesHit\": " << result.nrEnemiesHit
+				<< ", \"missedShots\": " << result.nrMissedShots
+				<< " }" << (i + 1 < results.size() ? "," : "") << "\n";
+		}
+		file << "]\n";
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (g_IsCountingAllocations) ++g_NrAllocations;
+
+	void* pMemory{ malloc(size == 0 ? 1 : size) };
+	if (!pMemory) throw std::bad_alloc{};
+	return pMemory;
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	free(pMemory);
+}
+
+// Usage: GPP_Benchmark [output file] [ticks per run] [tree|utility|goap|all]
+int main(int argc, char* argv[])
+{
+	const std::string outputFile{ argc > 1 ? argv[1] : "BenchmarkResults.json" };
+	const int maxTicks{ argc > 2 ? std::max(1, atoi(argv[2])) : 7200 };
+	const std::string decisionMakingFilter{ argc > 3 ? argv[3] : "all" };
+
+	const std::vector<std::string> levelFiles{ "GameLevel.gppl", "LevelOne.gppl", "LevelTwo.gppl", "LevelThree.gppl" };
+	const unsigned int seeds[]{ 1, 2, 3 };
+	const int enemyCounts[]{ 0, 20, 100 };
+
+	// Every decision making plays the same levels and seeds, so their quality and cost can be compared
+	std::vector<DecisionMakingType> decisionMakingTypes{};
+	for (DecisionMakingType decisionMakingType : { DecisionMakingType::BehaviorTree, DecisionMakingType::Utility, DecisionMakingType::GOAP })
+	{
+		if (decisionMakingFilter == "all" || decisionMakingFilter == GetDecisionMakingName(decisionMakingType))
+		{
+			decisionMakingTypes.push_back(decisionMakingType);
+		}
+	}
+	if (decisionMakingTypes.empty())
+	{
+		std::cout << "Unknown decision making " << decisionMakingFilter << "\n";
+		return 1;
+	}
+
+	std::vector<RunResult> results{};
+
+	for (DecisionMakingType decisionMakingType : decisionMakingTypes)
+	{
+		for (const std::string& levelFile : levelFiles)
+		{
+			LevelFile level{};
+			if (!level.Load(levelFile)) continue;
+
+			for (int nrEnemies : enemyCounts)
+			{
+				for (unsigned int seed : seeds)
+				{
+					// Keep the output of the plugin out of the results
+					std::streambuf* pCoutBuffer{ std::cout.rdbuf(nullptr) };
+					const RunResult result{ Run(level, RunSettings{ decisionMakingType, levelFile, seed, nrEnemies }, maxTicks) };
+					std::cout.rdbuf(pCoutBuffer);
+
+					printf("%-8s %-16s seed %u, %3d enemies: mean %7.2f us, p50 %7.2f us, p99 %8.2f us, max %8.2f us, %6.2f allocs/tick, survived %6.1f s, %3d items, %3d kills\n",
+						GetDecisionMakingName(decisionMakingType), levelFile.c_str(), seed, nrEnemies,
+						result.meanMicroseconds, result.p50Microseconds, result.p99Microseconds, result.maxMicroseconds,
+						result.allocationsPerTick, result.timeSurvived, result.nrItemsPickedUp, result.nrEnemiesKilled);
+
+					results.push_back(result);
+				}
+			}
+		}
+	}
+
+	// One line per decision making, summed over every run
+	for (DecisionMakingType decisionMakingType : decisionMakingTypes)
+	{
+		int nrRuns{};
+		double totalMeanMicroseconds{};
+		double worstP99Microseconds{};
+		double worstMaxMicroseconds{};
+		float totalTimeSurvived{};
+		int totalItemsPickedUp{};
+		int totalEnemiesKilled{};
+
+		for (const RunResult& result : results)
+		{
+			if (result.settings.decisionMakingType != decisionMakingType) continue;
+
+			++nrRuns;
+			totalMeanMicroseconds += result.meanMicroseconds;
+			worstP99Microseconds = std::max(worstP99Microseconds, result.p99Microseconds);
+			worstMaxMicroseconds = std::max(worstMaxMicroseconds, result.maxMicroseconds);
+			totalTimeSurvived += result.timeSurvived;
+			totalItemsPickedUp += result.nrItemsPickedUp;
+			totalEnemiesKilled += result.nrEnemiesKilled;
+		}
+		if (nrRuns == 0) continue;
+
+		printf("%-8s %3d runs: mean %7.2f us, worst p99 %8.2f us, worst max %8.2f us, survived %8.1f s, %5d items, %4d kills\n",
+			GetDecisionMakingName(decisionMakingType), nrRuns,
+			totalMeanMicroseconds / nrRuns, worstP99Microseconds, worstMaxMicroseconds,
+			totalTimeSurvived, totalItemsPickedUp, totalEnemiesKilled);
+	}
+
+	WriteResults(outputFile, results);
+	std::cout << "Wrote " << results.size() << " runs to " << outputFile << "\n";
+
+	return 0;
+}
@@ -0,0 +1,599 @@
+#include "../stdafx.h"
+#include "HeadlessInterface.h"
+
+namespace
+{
+	// Agent values, close to the ones of the exam framework
+	constexpr float maxStat{ 10.0f };
+	constexpr float walkSpeed{ 5.0f };
+	constexpr float runSpeed{ 10.0f };
+	constexpr float staminaDrain{ 2.0f };
+	constexpr float staminaRegen{ 1.0f };
+	constexpr float energyDrain{ 0.05f };
+	constexpr float starvingDamage{ 0.2f };
+
+	// Enemy values
+	constexpr float enemyChaseRange{ 40.0f };
+	constexpr float enemyBiteDamage{ 1.0f };
+	constexpr float biteCooldown{ 1.0f };
+	constexpr float wasBittenTime{ 0.5f };
+}
+
+HeadlessInterface::HeadlessInterface(const LevelFile& level, unsigned int seed, int nrEnemies, int nrItems)
+	: m_Random{ seed }
+	, m_WorldInfo{ level.GetWorldInfo() }
+{
+	// Only the bounds of the houses are used
+	for (const LevelHouse& house : level.GetHouses())
+	{
+		m_Houses.push_back(house.info);
+	}
+
+	// Init the agent in the center of the world
+	m_Agent.Stamina = maxStat;
+	m_Agent.Health = maxStat;
+	m_Agent.Energy = maxStat;
+	m_Agent.FOV_Angle = static_cast<float>(M_PI) / 2.0f;
+	m_Agent.FOV_Range = 20.0f;
+	m_Agent.Position = m_WorldInfo.Center;
+	m_Agent.MaxLinearSpeed = walkSpeed;
+	m_Agent.MaxAngularSpeed = static_cast<float>(M_PI);
+	m_Agent.GrabRange = 3.0f;
+	m_Agent.AgentSize = 1.5f;
+
+	// Init the inventory
+	for (ItemInfo& item : m_Inventory)
+	{
+		item.Type = eItemType::_LAST;
+	}
+
+	for (int i{}; i < nrItems; ++i)
+	{
+		SpawnItem();
+	}
+	for (int i{}; i < nrEnemies; ++i)
+	{
+		SpawnEnemy();
+	}
+
+	UpdateFov();
+}
+
+void HeadlessInterface::Step(const SteeringPlugin_Output& steering, float dt)
+{
+	m_Stats.TimeSurvived += dt;
+
+	MoveAgent(steering, dt);
+	MoveEnemies(dt);
+	UpdateFov();
+}
+
+bool HeadlessInterface::IsAgentDead() const
+{
+	return m_Agent.Death;
+}
+
+WorldInfo HeadlessInterface::World_GetInfo() const
+{
+	return m_WorldInfo;
+}
+
+StatisticsInfo HeadlessInterface::World_GetStats() const
+{
+	return m_Stats;
+}
+
+bool HeadlessInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	if (index >= m_HousesInFov.size()) return false;
+
+	houseInfo = m_HousesInFov[index];
+	return true;
+}
+
+bool HeadlessInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const
+{
+	if (index >= m_EntitiesInFov.size()) return false;
+
+	entityInfo = m_EntitiesInFov[index];
+	return true;
+}
+
+AgentInfo HeadlessInterface::Agent_GetInfo() const
+{
+	return m_Agent;
+}
+
+bool HeadlessInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	for (const EnemyInfo& curEnemy : m_Enemies)
+	{
+		if (curEnemy.EnemyHash != entity.EntityHash) continue;
+
+		enemy = curEnemy;
+		return true;
+	}
+	return false;
+}
+
+Elite::Vector2 HeadlessInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	// There are no walls, so the goal can always be reached directly
+	return goal;
+}
+
+bool HeadlessInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	if (slotId >= m_InventoryCapacity || m_IsSlotUsed[slotId]) return false;
+
+	m_Inventory[slotId] = item;
+	m_IsSlotUsed[slotId] = true;
+	return true;
+}
+
+bool HeadlessInterface::Inventory_UseItem(UINT slotId)
+{
+	if (slotId >= m_InventoryCapacity || !m_IsSlotUsed[slotId]) return false;
+
+	const ItemInfo& item{ m_Inventory[slotId] };
+	int& value{ m_ItemValues[item.ItemHash] };
+
+	switch (item.Type)
+	{
+	case eItemType::PISTOL:
+		if (value <= 0) return false;
+		--value;
+		Shoot(50.0f, 0.0f, 1, true);
+		return true;
+	case eItemType::SHOTGUN:
+		if (value <= 0) return false;
+		--value;
+		Shoot(15.0f, 0.25f, 2, false);
+		return true;
+	case eItemType::MEDKIT:
+		m_Agent.Health = std::min(maxStat, m_Agent.Health + value);
+		value = 0;
+		return true;
+	case eItemType::FOOD:
+		m_Agent.Energy = std::min(maxStat, m_Agent.Energy + value);
+		value = 0;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool HeadlessInterface::Inventory_RemoveItem(UINT slotId)
+{
+	if (slotId >= m_InventoryCapacity || !m_IsSlotUsed[slotId]) return false;
+
+	m_ItemValues.erase(m_Inventory[slotId].ItemHash);
+	m_Inventory[slotId].Type = eItemType::_LAST;
+	m_IsSlotUsed[slotId] = false;
+	return true;
+}
+
+bool HeadlessInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	if (slotId >= m_InventoryCapacity || !m_IsSlotUsed[slotId]) return false;
+
+	item = m_Inventory[slotId];
+	return true;
+}
+
+UINT HeadlessInterface::Inventory_GetCapacity() const
+{
+	return m_InventoryCapacity;
+}
+
+bool HeadlessInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	for (const ItemInfo& curItem : m_Items)
+	{
+		if (curItem.ItemHash != entity.EntityHash) continue;
+
+		item = curItem;
+		return true;
+	}
+	return false;
+}
+
+bool HeadlessInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	for (size_t i{}; i < m_Items.size(); ++i)
+	{
+		if (m_Items[i].ItemHash != entity.EntityHash) continue;
+
+		// Items can only be grabbed in grab range
+		if (m_Items[i].Location.DistanceSquared(m_Agent.Position) > m_Agent.GrabRange * m_Agent.GrabRange) return false;
+
+		item = m_Items[i];
+		m_Items[i] = m_Items[m_Items.size() - 1];
+		m_Items.pop_back();
+		++m_Stats.NumItemsPickUp;
+
+		// Keep the amount of items in the world the same
+		SpawnItem();
+		return true;
+	}
+	return false;
+}
+
+bool HeadlessInterface::Item_Destroy(EntityInfo entity)
+{
+	for (size_t i{}; i < m_Items.size(); ++i)
+	{
+		if (m_Items[i].ItemHash != entity.EntityHash) continue;
+
+		m_ItemValues.erase(m_Items[i].ItemHash);
+		m_Items[i] = m_Items[m_Items.size() - 1];
+		m_Items.pop_back();
+		return true;
+	}
+	return false;
+}
+
+int HeadlessInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	if (item.Type != eItemType::PISTOL && item.Type != eItemType::SHOTGUN) return -1;
+
+	const auto it{ m_ItemValues.find(item.ItemHash) };
+	return it == m_ItemValues.end() ? -1 : it->second;
+}
+
+int HeadlessInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	if (item.Type != eItemType::MEDKIT) return -1;
+
+	const auto it{ m_ItemValues.find(item.ItemHash) };
+	return it == m_ItemValues.end() ? -1 : it->second;
+}
+
+int HeadlessInterface::Food_GetEnergy(ItemInfo& item)
+{
+	if (item.Type != eItemType::FOOD) return -1;
+
+	const auto it{ m_ItemValues.find(item.ItemHash) };
+	return it == m_ItemValues.end() ? -1 : it->second;
+}
+
+bool HeadlessInterface::PurgeZone_GetInfo(EntityInfo, PurgeZoneInfo&)
+{
+	return false;
+}
+
+Elite::Vector2 HeadlessInterface::Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const
+{
+	return screenPos;
+}
+
+Elite::Vector2 HeadlessInterface::Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const
+{
+	return worldPos;
+}
+
+bool HeadlessInterface::Input_IsKeyboardKeyDown(Elite::InputScancode) const
+{
+	return false;
+}
+
+bool HeadlessInterface::Input_IsKeyboardKeyUp(Elite::InputScancode) const
+{
+	return false;
+}
+
+bool HeadlessInterface::Input_IsMouseButtonDown(Elite::InputMouseButton) const
+{
+	return false;
+}
+
+bool HeadlessInterface::Input_IsMouseButtonUp(Elite::InputMouseButton) const
+{
+	return false;
+}
+
+Elite::MouseData HeadlessInterface::Input_GetMouseData(Elite::InputType, Elite::InputMouseButton) const
+{
+	return Elite::MouseData{};
+}
+
+void HeadlessInterface::RequestShutdown() const
+{
+}
+
+void HeadlessInterface::Draw_Polygon(const Elite::Vector2*, int, const Elite::Vector3&, float)
+{
+}
+
+void HeadlessInterface::Draw_SolidPolygon(const Elite::Vector2*, int, const Elite::Vector3&, float, bool)
+{
+}
+
+void HeadlessInterface::Draw_Circle(const Elite::Vector2&, float, const Elite::Vector3&, float)
+{
+}
+
+void HeadlessInterface::Draw_SolidCircle(const Elite::Vector2&, float, const Elite::Vector2&, const Elite::Vector3&, float)
+{
+}
+
+void HeadlessInterface::Draw_Segment(const Elite::Vector2&, const Elite::Vector2&, const Elite::Vector3&, float)
+{
+}
+
+void HeadlessInterface::Draw_Direction(const Elite::Vector2&, Elite::Vector2, float, const Elite::Vector3&, float)
+{
+}
+
+void HeadlessInterface::Draw_Transform(const b2Transform&, float)
+{
+}
+
+void HeadlessInterface::Draw_Point(const Elite::Vector2&, float, const Elite::Vector3&, float)
+{
+}
+
+float HeadlessInterface::NextDepthSlice()
+{
+	return 0.0f;
+}
+
+void HeadlessInterface::SpawnItem()
+{
+	// Every item type is equally likely
+	std::uniform_int_distribution<int> typeDistribution{ static_cast<int>(eItemType::PISTOL), static_cast<int>(eItemType::GARBAGE) };
+
+	ItemInfo item{};
+	item.Type = static_cast<eItemType>(typeDistribution(m_Random));
+	item.Location = GetRandomPositionInHouse();
+	item.ItemHash = m_NextHash++;
+
+	// Roll the ammo, health or energy
+	int minValue{};
+	int maxValue{};
+	switch (item.Type)
+	{
+	case eItemType::PISTOL: minValue = 5; maxValue = 20; break;
+	case eItemType::SHOTGUN: minValue = 2; maxValue = 8; break;
+	case eItemType::MEDKIT: minValue = 1; maxValue = 5; break;
+	case eItemType::FOOD: minValue = 2; maxValue = 8; break;
+	default: break;
+	}
+	m_ItemValues[item.ItemHash] = std::uniform_int_distribution<int>{ minValue, maxValue }(m_Random);
+
+	m_Items.push_back(item);
+}
+
+void HeadlessInterface::SpawnEnemy()
+{
+	std::uniform_int_distribution<int> typeDistribution{ static_cast<int>(eEnemyType::ZOMBIE_NORMAL), static_cast<int>(eEnemyType::ZOMBIE_HEAVY) };
+
+	EnemyInfo enemy{};
+	enemy.Type = static_cast<eEnemyType>(typeDistribution(m_Random));
+	enemy.EnemyHash = m_NextHash++;
+
+	// Never spawn on top of the agent
+	constexpr float minSpawnDistance{ 30.0f };
+	do
+	{
+		enemy.Location = GetRandomPosition();
+	} while (enemy.Location.DistanceSquared(m_Agent.Position) < minSpawnDistance * minSpawnDistance);
+
+	switch (enemy.Type)
+	{
+	case eEnemyType::ZOMBIE_RUNNER: enemy.Size = 1.0f; enemy.Health = 1.0f; break;
+	case eEnemyType::ZOMBIE_HEAVY: enemy.Size = 2.0f; enemy.Health = 5.0f; break;
+	default: enemy.Size = 1.5f; enemy.Health = 2.0f; break;
+	}
+
+	m_Enemies.push_back(enemy);
+}
+
+Elite::Vector2 HeadlessInterface::GetRandomPosition()
+{
+	const Elite::Vector2 halfDimensions{ m_WorldInfo.Dimensions / 2.0f };
+	std::uniform_real_distribution<float> xDistribution{ -halfDimensions.x, halfDimensions.x };
+	std::uniform_real_distribution<float> yDistribution{ -halfDimensions.y, halfDimensions.y };
+
+	return m_WorldInfo.Center + Elite::Vector2{ xDistribution(m_Random), yDistribution(m_Random) };
+}
+
+Elite::Vector2 HeadlessInterface::GetRandomPositionInHouse()
+{
+	// Without houses, items lie anywhere
+	if (m_Houses.empty()) return GetRandomPosition();
+
+	const HouseInfo& house{ m_Houses[std::uniform_int_distribution<size_t>{ 0, m_Houses.size() - 1 }(m_Random)] };
+
+	// Stay away from the walls
+	std::uniform_real_distribution<float> offsetDistribution{ -0.4f, 0.4f };
+	return house.Center + Elite::Vector2{ offsetDistribution(m_Random) * house.Size.x, offsetDistribution(m_Random) * house.Size.y };
+}
+
+void HeadlessInterface::MoveAgent(const SteeringPlugin_Output& steering, float dt)
+{
+	// Running drains stamina, walking regenerates it
+	const bool isRunning{ steering.RunMode && m_Agent.Stamina > 0.0f };
+	m_Agent.RunMode = isRunning;
+	m_Agent.Stamina = isRunning ? std::max(0.0f, m_Agent.Stamina - staminaDrain * dt) : std::min(maxStat, m_Agent.Stamina + staminaRegen * dt);
+
+	// Clamp the requested velocity to the speed of the agent
+	const float maxSpeed{ isRunning ? runSpeed : walkSpeed };
+	m_Agent.MaxLinearSpeed = maxSpeed;
+	Elite::Vector2 velocity{ steering.LinearVelocity };
+	if (velocity.MagnitudeSquared() > maxSpeed * maxSpeed) velocity = velocity.GetNormalized() * maxSpeed;
+
+	m_Agent.LinearVelocity = velocity;
+	m_Agent.CurrentLinearSpeed = velocity.Magnitude();
+	m_Agent.Position += velocity * dt;
+
+	// Stay inside the world
+	const Elite::Vector2 halfDimensions{ m_WorldInfo.Dimensions / 2.0f };
+	m_Agent.Position.x = Elite::Clamp(m_Agent.Position.x, m_WorldInfo.Center.x - halfDimensions.x, m_WorldInfo.Center.x + halfDimensions.x);
+	m_Agent.Position.y = Elite::Clamp(m_Agent.Position.y, m_WorldInfo.Center.y - halfDimensions.y, m_WorldInfo.Center.y + halfDimensions.y);
+
+	// Rotate
+	if (steering.AutoOrient)
+	{
+		m_Agent.AngularVelocity = 0.0f;
+		if (m_Agent.CurrentLinearSpeed > FLT_EPSILON) m_Agent.Orientation = atan2f(velocity.y, velocity.x);
+	}
+	else
+	{
+		m_Agent.AngularVelocity = Elite::Clamp(steering.AngularVelocity, -m_Agent.MaxAngularSpeed, m_Agent.MaxAngularSpeed);
+		m_Agent.Orientation += m_Agent.AngularVelocity * dt;
+	}
+
+	// Energy runs out over time, without energy the agent loses health
+	m_Agent.Energy = std::max(0.0f, m_Agent.Energy - energyDrain * dt);
+	if (m_Agent.Energy <= 0.0f) m_Agent.Health -= starvingDamage * dt;
+
+	// Check if the agent is inside a house
+	m_Agent.IsInHouse = false;
+	for (const HouseInfo& house : m_Houses)
+	{
+		const Elite::Vector2 offset{ m_Agent.Position - house.Center };
+		if (abs(offset.x) < house.Size.x / 2.0f && abs(offset.y) < house.Size.y / 2.0f)
+		{
+			m_Agent.IsInHouse = true;
+			break;
+		}
+	}
+}
+
+void HeadlessInterface::MoveEnemies(float dt)
+{
+	m_Agent.Bitten = false;
+	m_BiteCooldown -= dt;
+	m_WasBittenTimer -= dt;
+
+	for (EnemyInfo& enemy : m_Enemies)
+	{
+		const Elite::Vector2 toAgent{ m_Agent.Position - enemy.Location };
+		const float distance{ toAgent.Magnitude() };
+
+		// Only chase the agent when it is close
+		if (distance > enemyChaseRange)
+		{
+			enemy.LinearVelocity = Elite::Vector2{};
+			continue;
+		}
+
+		const float speed{ enemy.Type == eEnemyType::ZOMBIE_RUNNER ? 6.0f : (enemy.Type == eEnemyType::ZOMBIE_HEAVY ? 2.0f : 3.5f) };
+		enemy.LinearVelocity = distance > FLT_EPSILON ? toAgent / distance * speed : Elite::Vector2{};
+		enemy.Location += enemy.LinearVelocity * dt;
+
+		// Bite the agent
+		if (distance < enemy.Size + m_Agent.AgentSize && m_BiteCooldown <= 0.0f)
+		{
+			m_Agent.Health -= enemyBiteDamage;
+			m_Agent.Bitten = true;
+			m_BiteCooldown = biteCooldown;
+			m_WasBittenTimer = wasBittenTime;
+		}
+	}
+
+	m_Agent.WasBitten = m_WasBittenTimer > 0.0f;
+	m_Agent.Death = m_Agent.Health <= 0.0f;
+}
+
+void HeadlessInterface::Shoot(float range, float halfAngle, int damage, bool hitsFirstOnly)
+{
+	const Elite::Vector2 lookDirection{ cosf(m_Agent.Orientation), sinf(m_Agent.Orientation) };
+
+	bool hasHit{};
+	float closestDistance{ FLT_MAX };
+	size_t closestEnemy{};
+
+	for (size_t i{}; i < m_Enemies.size(); ++i)
+	{
+		const Elite::Vector2 toEnemy{ m_Enemies[i].Location - m_Agent.Position };
+		const float distance{ toEnemy.Magnitude() };
+		if (distance > range) continue;
+
+		// A bullet hits when it passes through the enemy, a shotgun hits everything in its cone
+		const float sideDistance{ abs(lookDirection.Cross(toEnemy)) };
+		const bool isInFront{ lookDirection.Dot(toEnemy) > 0.0f };
+		const bool isHit{ isInFront && (sideDistance < m_Enemies[i].Size || sideDistance < distance * tanf(halfAngle)) };
+		if (!isHit) continue;
+
+		if (hitsFirstOnly)
+		{
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				closestEnemy = i;
+				hasHit = true;
+			}
+			continue;
+		}
+
+		hasHit = true;
+		++m_Stats.NumEnemiesHit;
+		m_Enemies[i].Health -= damage;
+	}
+
+	if (hitsFirstOnly && hasHit)
+	{
+		++m_Stats.NumEnemiesHit;
+		m_Enemies[closestEnemy].Health -= damage;
+	}
+
+	if (!hasHit) ++m_Stats.NumMissedShots;
+
+	// Replace killed enemies, so the amount of enemies stays the same
+	for (size_t i{}; i < m_Enemies.size();)
+	{
+		if (m_Enemies[i].Health > 0.0f)
+		{
+			++i;
+			continue;
+		}
+
+		++m_Stats.NumEnemiesKilled;
+		m_Enemies[i] = m_Enemies[m_Enemies.size() - 1];
+		m_Enemies.pop_back();
+		SpawnEnemy();
+	}
+}
+
+void HeadlessInterface::UpdateFov()
+{
+	m_HousesInFov.clear();
+	m_EntitiesInFov.clear();
+
+	// A house is seen when its center or one of its corners is in the fov
+	for (const HouseInfo& house : m_Houses)
+	{
+		const Elite::Vector2 halfSize{ house.Size / 2.0f };
+		if (IsInFov(house.Center)
+			|| IsInFov(house.Center + Elite::Vector2{ halfSize.x, halfSize.y })
+			|| IsInFov(house.Center + Elite::Vector2{ -halfSize.x, halfSize.y })
+			|| IsInFov(house.Center + Elite::Vector2{ halfSize.x, -halfSize.y })
+			|| IsInFov(house.Center + Elite::Vector2{ -halfSize.x, -halfSize.y }))
+		{
+			m_HousesInFov.push_back(house);
+		}
+	}
+
+	for (const ItemInfo& item : m_Items)
+	{
+		if (IsInFov(item.Location)) m_EntitiesInFov.push_back(EntityInfo{ eEntityType::ITEM, item.Location, item.ItemHash });
+	}
+
+	for (const EnemyInfo& enemy : m_Enemies)
+	{
+		if (IsInFov(enemy.Location)) m_EntitiesInFov.push_back(EntityInfo{ eEntityType::ENEMY, enemy.Location, enemy.EnemyHash });
+	}
+}
+
+bool HeadlessInterface::IsInFov(const Elite::Vector2& position) const
+{
+	const Elite::Vector2 toPosition{ position - m_Agent.Position };
+	const float distanceSqr{ toPosition.MagnitudeSquared() };
+	if (distanceSqr > m_Agent.FOV_Range * m_Agent.FOV_Range) return false;
+	if (distanceSqr < FLT_EPSILON) return true;
+
+	const Elite::Vector2 lookDirection{ cosf(m_Agent.Orientation), sinf(m_Agent.Orientation) };
+	return lookDirection.Dot(toPosition) / sqrtf(distanceSqr) >= cosf(m_Agent.FOV_Angle / 2.0f);
+}
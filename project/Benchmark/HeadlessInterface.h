@@ -0,0 +1,108 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <IExamInterface.h>
+#include <unordered_map>
+#include "../LevelFile.h"
+
+// A stand-in for the exam framework without rendering, physics or a navmesh
+// Houses come from the level file, items are spawned inside the houses and enemies chase the agent
+// Walls do not block movement and there are no purge zones, this world only exists to feed the plugin with data
+class HeadlessInterface final : public IExamInterface
+{
+public:
+	HeadlessInterface(const LevelFile& level, unsigned int seed, int nrEnemies, int nrItems);
+
+	void Step(const SteeringPlugin_Output& steering, float dt);
+	bool IsAgentDead() const;
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override;
+	StatisticsInfo World_GetStats() const override;
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& entityInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override;
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override;
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override;
+	int Medkit_GetHealth(ItemInfo& item) override;
+	int Food_GetEnergy(ItemInfo& item) override;
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override;
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override;
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override;
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override;
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override;
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override;
+	Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button = Elite::InputMouseButton(0)) const override;
+
+	//EVENT
+	void RequestShutdown() const override;
+
+	//RENDERER
+	void Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth) override;
+	void Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth, bool triangulate = false) override;
+	void Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color, float depth) override;
+	void Draw_SolidCircle(const Elite::Vector2& center, float radius, const Elite::Vector2& axis, const Elite::Vector3& color, float depth) override;
+	void Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color, float depth) override;
+	void Draw_Direction(const Elite::Vector2& p, Elite::Vector2 dir, float length, const Elite::Vector3& color, float depth = 0.9f) override;
+	void Draw_Transform(const b2Transform& xf, float depth) override;
+	void Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color, float depth) override;
+	float NextDepthSlice() override;
+private:
+	void SpawnItem();
+	void SpawnEnemy();
+	Elite::Vector2 GetRandomPosition();
+	Elite::Vector2 GetRandomPositionInHouse();
+
+	void MoveAgent(const SteeringPlugin_Output& steering, float dt);
+	void MoveEnemies(float dt);
+	void Shoot(float range, float halfAngle, int damage, bool hitsFirstOnly);
+	void UpdateFov();
+	bool IsInFov(const Elite::Vector2& position) const;
+
+	std::mt19937 m_Random;
+
+	WorldInfo m_WorldInfo{};
+	std::vector<HouseInfo> m_Houses{};
+	StatisticsInfo m_Stats{};
+	AgentInfo m_Agent{};
+	float m_BiteCooldown{};
+	float m_WasBittenTimer{};
+
+	std::vector<ItemInfo> m_Items{};
+	std::vector<EnemyInfo> m_Enemies{};
+	int m_NextHash{ 1 };
+
+	// Ammo, health or energy of every item, by item hash
+	std::unordered_map<int, int> m_ItemValues{};
+
+	constexpr static UINT m_InventoryCapacity{ 5 };
+	ItemInfo m_Inventory[m_InventoryCapacity]{};
+	bool m_IsSlotUsed[m_InventoryCapacity]{};
+
+	// Everything the agent sees this frame
+	std::vector<HouseInfo> m_HousesInFov{};
+	std::vector<EntityInfo> m_EntitiesInFov{};
+};
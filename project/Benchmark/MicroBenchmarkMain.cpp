@@ -0,0 +1,714 @@
+#include "../stdafx.h"
+#include <chrono>
+#include "HeadlessInterface.h"
+#include "../WorldExplorer.h"
+#include "../DiscoveryPyramid.h"
+#include "../Behaviors.h"
+
+namespace
+{
+	// Every call adds its result here, so the compiler can not remove the call
+	volatile int g_Sink{};
+
+	struct MicroResult
+	{
+		std::string name;
+		int nrCallsPerSample;
+		double minNanoseconds;
+		double medianNanoseconds;
+		double p90Nanoseconds;
+	};
+
+	// A fixed amount of calls per sample and a fixed amount of samples,
+	// so runs can be compared and a profiler can attach to one benchmark at a time
+	constexpr int nrWarmupSamples{ 10 };
+	constexpr int nrSamples{ 50 };
+	constexpr int maxCallsPerSample{ 10000 };
+
+	class MicroBenchmarks final
+	{
+	public:
+		explicit MicroBenchmarks(const std::string& filter)
+			: m_Filter{ filter }
+		{
+		}
+
+		// Measures the time of one call of the function, which returns something that can be converted to an int
+		template<typename Function>
+		void Measure(const std::string& name, int nrCallsPerSample, Function function)
+		{
+			if (!m_Filter.empty() && name.find(m_Filter) == std::string::npos) return;
+
+			nrCallsPerSample = std::max(1, std::min(nrCallsPerSample, maxCallsPerSample));
+
+			// Fill the caches and train the branch predictor
+			for (int i{}; i < nrWarmupSamples * nrCallsPerSample; ++i)
+			{
+				g_Sink = g_Sink + static_cast<int>(function());
+			}
+
+			std::vector<double> samples(nrSamples);
+			for (double& sample : samples)
+			{
+				const auto start{ std::chrono::high_resolution_clock::now() };
+				for (int i{}; i < nrCallsPerSample; ++i)
+				{
+					g_Sink = g_Sink + static_cast<int>(function());
+				}
+				const auto end{ std::chrono::high_resolution_clock::now() };
+
+				sample = std::chrono::duration<double, std::nano>(end - start).count() / nrCallsPerSample;
+			}
+
+			std::sort(samples.begin(), samples.end());
+
+			const MicroResult result{ name, nrCallsPerSample, samples.front(), samples[nrSamples / 2], samples[nrSamples * 9 / 10] };
+			printf("%-40s min %10.1f ns, median %10.1f ns, p90 %10.1f ns\n", name.c_str(), result.minNanoseconds, result.medianNanoseconds, result.p90Nanoseconds);
+
+			m_Results.push_back(result);
+		}
+
+		void WriteResults(const std::string& filePath) const
+		{
+			std::ofstream file{ filePath };
+			if (!file)
+			{
+				std::cout << "Could not write " << filePath << "\n";
+				return;
+			}
+
+			file << "[\n";
+			for (size_t i{}; i < m_Results.size(); ++i)
+			{
+				const MicroResult& result{ m_Results[i] };
+				file << "\t{ \"name\": \"" << result.name << "\""
+					<< ", \"callsPerSample\": " << result.nrCallsPerSample
+					<< ", \"minNs\": " << result.minNanoseconds
+					<< ", \"medianNs\": " << result.medianNanoseconds
+					<< ", \"p90Ns\": " << result.p90Nanoseconds
+					<< " }" << (i + 1 < m_Results.size() ? "," : "") << "\n";
+			}
+			file << "]\n";
+		}
+
+	private:
+		std::string m_Filter;
+		std::vector<MicroResult> m_Results{};
+	};
+
+	bool ReturnTrue(Elite::Blackboard*)
+	{
+		return true;
+	}
+
+	bool ReturnFalse(Elite::Blackboard*)
+	{
+		return false;
+	}
+
+	Elite::BehaviorState ReturnSuccess(Elite::Blackboard*)
+	{
+		return Elite::BehaviorState::Success;
+	}
+
+	// Runs for a fixed amount of frames, the counter lives in the coroutine frame
+	Elite::BehaviorRoutine CountFrames(Elite::BehaviorRoutinePool&, Elite::Blackboard*)
+	{
+		constexpr int nrFrames{ 16 };
+		for (int i{}; i < nrFrames; ++i)
+		{
+			co_yield Elite::BehaviorState::Running;
+		}
+		co_return Elite::BehaviorState::Success;
+	}
+
+	// A blackboard with a given amount of fields besides the one that is read
+	Elite::Blackboard* CreateBlackboard(int nrFields)
+	{
+		Elite::Blackboard* pBlackboard{ new Elite::Blackboard{} };
+		for (int i{}; i < nrFields; ++i)
+		{
+			pBlackboard->AddData("Field" + std::to_string(i), static_cast<float>(i));
+		}
+		pBlackboard->AddData("Target", Elite::Vector2{});
+		return pBlackboard;
+	}
+
+	void BenchmarkBlackboard(MicroBenchmarks& benchmarks)
+	{
+		for (int nrFields : { 8, 64, 512 })
+		{
+			Elite::Blackboard* pBlackboard{ CreateBlackboard(nrFields) };
+
+			benchmarks.Measure("Blackboard/GetData/" + std::to_string(nrFields), 10000, [pBlackboard]()
+				{
+					Elite::Vector2 target{};
+					return pBlackboard->GetData("Target", target);
+				});
+
+			benchmarks.Measure("Blackboard/ChangeData/" + std::to_string(nrFields), 10000, [pBlackboard]()
+				{
+					return pBlackboard->ChangeData("Target", Elite::Vector2{ 1.0f, 2.0f });
+				});
+
+			// The field is bound once, every call reads or writes the stored value directly
+			Elite::BlackboardHandle<Elite::Vector2> target{ pBlackboard->Bind<Elite::Vector2>("Target") };
+			benchmarks.Measure("Blackboard/View/" + std::to_string(nrFields), 10000, [target]()
+				{
+					return target.View().x > 0.0f;
+				});
+
+			benchmarks.Measure("Blackboard/Get/" + std::to_string(nrFields), 10000, [target]() mutable
+				{
+					target.Get().x += 1.0f;
+					return target.View().x > 0.0f;
+				});
+
+			// How the node functions read a field, the binding is kept between calls
+			Elite::CachedBlackboardHandle<Elite::Vector2> cachedTarget{ "Target" };
+			benchmarks.Measure("Blackboard/CachedBind/" + std::to_string(nrFields), 10000, [pBlackboard, &cachedTarget]()
+				{
+					return cachedTarget.Bind(pBlackboard).View().x > 0.0f;
+				});
+
+			delete pBlackboard;
+		}
+	}
+
+	// A temporary vector that is filled and thrown away, like the per frame data of the plugin
+	void BenchmarkFrameArena(MicroBenchmarks& benchmarks)
+	{
+		FrameArena* pFrameArena{ new FrameArena{ 16 * 1024 } };
+
+		for (int nrElements : { 4, 32, 256 })
+		{
+			benchmarks.Measure("Vector/Heap/" + std::to_string(nrElements), 10000, [nrElements]()
+				{
+					std::vector<EntityInfo> entities{};
+					for (int i{}; i < nrElements; ++i)
+					{
+						entities.push_back(EntityInfo{ eEntityType::ITEM, Elite::Vector2{}, i });
+					}
+					return entities.size();
+				});
+
+			benchmarks.Measure("Vector/FrameArena/" + std::to_string(nrElements), 10000, [pFrameArena, nrElements]()
+				{
+					// Every call is one frame
+					pFrameArena->Reset();
+
+					FrameVector<EntityInfo> entities{ FrameAllocator<EntityInfo>{ pFrameArena } };
+					for (int i{}; i < nrElements; ++i)
+					{
+						entities.push_back(EntityInfo{ eEntityType::ITEM, Elite::Vector2{}, i });
+					}
+					return entities.size();
+				});
+		}
+
+		delete pFrameArena;
+	}
+
+	// Every child of the selector fails, so every child is executed
+	Elite::IBehavior* CreateWideSelector(Elite::BehaviorArena& arena, int width)
+	{
+		std::vector<Elite::IBehavior*> children{};
+		for (int i{}; i < width; ++i)
+		{
+			children.push_back(arena.Create<Elite::BehaviorConditional>(ReturnFalse));
+		}
+		return arena.CreateComposite<Elite::BehaviorSelector>(children.data(), static_cast<unsigned int>(children.size()));
+	}
+
+	// Every child of the sequence succeeds, so every child is executed
+	Elite::IBehavior* CreateWideSequence(Elite::BehaviorArena& arena, int width)
+	{
+		std::vector<Elite::IBehavior*> children{};
+		for (int i{}; i < width; ++i)
+		{
+			children.push_back(arena.Create<Elite::BehaviorConditional>(ReturnTrue));
+		}
+		return arena.CreateComposite<Elite::BehaviorSequence>(children.data(), static_cast<unsigned int>(children.size()));
+	}
+
+	// Each selector fails its condition and goes one level deeper
+	Elite::IBehavior* CreateDeepSelector(Elite::BehaviorArena& arena, int depth)
+	{
+		Elite::IBehavior* pBehavior{ arena.Create<Elite::BehaviorAction>(ReturnSuccess) };
+		for (int i{}; i < depth; ++i)
+		{
+			pBehavior = arena.CreateComposite<Elite::BehaviorSelector>(
+				{
+					arena.Create<Elite::BehaviorConditional>(ReturnFalse),
+					pBehavior
+				});
+		}
+		return pBehavior;
+	}
+
+	// Each sequence passes its condition and goes one level deeper
+	Elite::IBehavior* CreateDeepSequence(Elite::BehaviorArena& arena, int depth)
+	{
+		Elite::IBehavior* pBehavior{ arena.Create<Elite::BehaviorAction>(ReturnSuccess) };
+		for (int i{}; i < depth; ++i)
+		{
+			pBehavior = arena.CreateComposite<Elite::BehaviorSequence>(
+				{
+					arena.Create<Elite::BehaviorConditional>(ReturnTrue),
+					pBehavior
+				});
+		}
+		return pBehavior;
+	}
+
+	template<typename T, size_t index>
+	struct Repeat
+	{
+		using Type = T;
+	};
+
+	template<template<typename...> class Composite, typename Child, size_t... indices>
+	Composite<typename Repeat<Child, indices>::Type...> MakeStaticWide(std::index_sequence<indices...>);
+
+	// The static version of CreateWideSelector and CreateWideSequence
+	template<template<typename...> class Composite, typename Child, size_t width>
+	using StaticWide = decltype(MakeStaticWide<Composite, Child>(std::make_index_sequence<width>{}));
+
+	// The static version of CreateDeepSelector and CreateDeepSequence
+	template<template<typename...> class Composite, bool(*fpConditional)(Elite::Blackboard*), int depth>
+	struct StaticDeep
+	{
+		using Type = Composite<Elite::Static::Cond<fpConditional>, typename StaticDeep<Composite, fpConditional, depth - 1>::Type>;
+	};
+	template<template<typename...> class Composite, bool(*fpConditional)(Elite::Blackboard*)>
+	struct StaticDeep<Composite, fpConditional, 0>
+	{
+		using Type = Elite::Static::Act<ReturnSuccess>;
+	};
+
+	template<int size>
+	void BenchmarkStaticBehaviorTree(MicroBenchmarks& benchmarks, Elite::Blackboard* pBlackboard)
+	{
+		using namespace Elite::Static;
+
+		benchmarks.Measure("StaticBehaviorTree/Selector/Width/" + std::to_string(size), 1000, [tree = StaticWide<Selector, Cond<ReturnFalse>, size>{}, pBlackboard]() mutable
+			{
+				return tree.Execute(pBlackboard);
+			});
+
+		benchmarks.Measure("StaticBehaviorTree/Sequence/Width/" + std::to_string(size), 1000, [tree = StaticWide<Sequence, Cond<ReturnTrue>, size>{}, pBlackboard]() mutable
+			{
+				return tree.Execute(pBlackboard);
+			});
+
+		benchmarks.Measure("StaticBehaviorTree/Selector/Depth/" + std::to_string(size), 1000, [tree = typename StaticDeep<Selector, ReturnFalse, size>::Type{}, pBlackboard]() mutable
+			{
+				return tree.Execute(pBlackboard);
+			});
+
+		benchmarks.Measure("StaticBehaviorTree/Sequence/Depth/" + std::to_string(size), 1000, [tree = typename StaticDeep<Sequence, ReturnTrue, size>::Type{}, pBlackboard]() mutable
+			{
+				return tree.Execute(pBlackboard);
+			});
+	}
+
+	void BenchmarkBehaviorTree(MicroBenchmarks& benchmarks)
+	{
+		Elite::Blackboard blackboard{};
+		Elite::Blackboard* pBlackboard{ &blackboard };
+
+		for (int size : { 4, 16, 64 })
+		{
+			Elite::BehaviorArena arena{};
+
+			Elite::IBehavior* pWideSelector{ CreateWideSelector(arena, size) };
+			benchmarks.Measure("BehaviorTree/Selector/Width/" + std::to_string(size), 1000, [pWideSelector, pBlackboard]()
+				{
+					return pWideSelector->Execute(pBlackboard);
+				});
+
+			Elite::IBehavior* pWideSequence{ CreateWideSequence(arena, size) };
+			benchmarks.Measure("BehaviorTree/Sequence/Width/" + std::to_string(size), 1000, [pWideSequence, pBlackboard]()
+				{
+					return pWideSequence->Execute(pBlackboard);
+				});
+
+			Elite::IBehavior* pDeepSelector{ CreateDeepSelector(arena, size) };
+			benchmarks.Measure("BehaviorTree/Selector/Depth/" + std::to_string(size), 1000, [pDeepSelector, pBlackboard]()
+				{
+					return pDeepSelector->Execute(pBlackboard);
+				});
+
+			Elite::IBehavior* pDeepSequence{ CreateDeepSequence(arena, size) };
+			benchmarks.Measure("BehaviorTree/Sequence/Depth/" + std::to_string(size), 1000, [pDeepSequence, pBlackboard]()
+				{
+					return pDeepSequence->Execute(pBlackboard);
+				});
+		}
+
+		// Mostly resumes, every 17th execution restarts the routine in the frame of the previous run
+		Elite::BehaviorRoutinePool routinePool{};
+		Elite::BehaviorCoroutine routine{ &routinePool, CountFrames };
+		benchmarks.Measure("BehaviorTree/Routine", 1000, [&routine, pBlackboard]()
+			{
+				return routine.Execute(pBlackboard);
+			});
+
+		BenchmarkStaticBehaviorTree<4>(benchmarks, pBlackboard);
+		BenchmarkStaticBehaviorTree<16>(benchmarks, pBlackboard);
+		BenchmarkStaticBehaviorTree<64>(benchmarks, pBlackboard);
+	}
+
+	// Everything the behaviors read from the blackboard, around an agent in the first level
+	class BehaviorWorld final
+	{
+	public:
+		explicit BehaviorWorld(const LevelFile& level)
+			: m_World{ level, 0, 20, 40 }
+			, m_Explorer{ level.GetWorldInfo() }
+			, m_Houses{ level.GetWorldInfo() }
+			, m_Inventory{ &m_World }
+			, m_Scheduler{ 200 }
+			, m_EnemyPredictor{ &m_EnemyTracker }
+			, m_FrameArena{ 16 * 1024 }
+			, m_ItemMemory{ 256 }
+		{
+			m_Steering.SetMode(Steering::Mode::Context);
+
+			IExamInterface* pInterface{ &m_World };
+			m_Blackboard.AddData("Interface", pInterface);
+			m_Blackboard.AddData("Explorer", &m_Explorer);
+			m_Blackboard.AddData("Inventory", &m_Inventory);
+			m_Blackboard.AddData("HouseFovVec", &m_HousesInFov);
+			m_Blackboard.AddData("Houses", &m_Houses);
+			m_Blackboard.AddData("EntityFovVec", &m_EntitiesInFov);
+			m_Blackboard.AddData("ItemMemory", &m_ItemMemory);
+			m_Blackboard.AddData("CurHouse", CurrentHouse{});
+			m_Blackboard.AddData("CurLoot", EntityInfo{});
+			m_Blackboard.AddData("HouseTarget", Elite::Vector2{});
+			m_Blackboard.AddData("EntityTarget", Elite::Vector2{});
+			m_Blackboard.AddData("Steering", &m_Steering);
+			m_Blackboard.AddData("Scheduler", &m_Scheduler);
+			m_Blackboard.AddData("Perception", &m_Perception);
+			m_Blackboard.AddData("SweepPlanner", &m_SweepPlanner);
+			m_Blackboard.AddData("LootTour", &m_LootTour);
+			m_Blackboard.AddData("EnemyTracker", &m_EnemyTracker);
+			m_Blackboard.AddData("EnemyPredictor", &m_EnemyPredictor);
+			m_Blackboard.AddData("PathCache", &m_PathCache);
+			m_Blackboard.AddData("FrameArena", &m_FrameArena);
+			m_Blackboard.AddData("ReplaceIndex", UINT(0));
+			m_Blackboard.AddData("LookingForEnemy", false);
+			m_Blackboard.AddData("DeltaTime", m_DeltaTime);
+			m_Blackboard.AddData("AgentInfo", &m_AgentInfo);
+
+			Sense();
+		}
+
+		Elite::Blackboard* GetBlackboard()
+		{
+			return &m_Blackboard;
+		}
+
+		// Executes the tree on the current frame and moves the world one frame further, the same way the plugin does
+		template<typename Tree>
+		Elite::BehaviorState Tick(Tree& tree)
+		{
+			m_FrameArena.Reset();
+			const Elite::BehaviorState state{ tree.Execute(&m_Blackboard) };
+			m_Scheduler.Update();
+			m_World.Step(m_Steering.Update(m_AgentInfo, m_DeltaTime), m_DeltaTime);
+			Sense();
+			return state;
+		}
+
+	private:
+		void Sense()
+		{
+			m_HousesInFov.clear();
+			HouseInfo house{};
+			for (UINT i{}; m_World.Fov_GetHouseByIndex(i, house); ++i)
+			{
+				m_HousesInFov.push_back(house);
+			}
+
+			m_EntitiesInFov.clear();
+			EntityInfo entity{};
+			for (UINT i{}; m_World.Fov_GetEntityByIndex(i, entity); ++i)
+			{
+				m_EntitiesInFov.push_back(entity);
+			}
+
+			m_AgentInfo = m_World.Agent_GetInfo();
+			m_Perception.Update(m_EntitiesInFov, m_AgentInfo.Position, m_Houses);
+			m_ItemMemory.Update(m_Perception);
+			m_EnemyTracker.Update(&m_World, m_Perception, m_AgentInfo, m_DeltaTime);
+			m_SweepPlanner.SetFov(m_AgentInfo.FOV_Range, m_AgentInfo.FOV_Angle);
+			m_Explorer.Update(m_AgentInfo);
+			m_Inventory.Update(m_AgentInfo.Health, m_AgentInfo.Energy);
+		}
+
+		const float m_DeltaTime{ 1.0f / 60.0f };
+
+		HeadlessInterface m_World;
+		WorldExplorer m_Explorer;
+		HouseRegistry m_Houses;
+		InventoryManager m_Inventory;
+		Steering m_Steering{};
+		TaskScheduler m_Scheduler;
+		Perception m_Perception{};
+		SweepPlanner m_SweepPlanner{};
+		LootTourPlanner m_LootTour{};
+		EnemyTracker m_EnemyTracker{};
+		EnemyPredictor m_EnemyPredictor;
+		PathCache m_PathCache{};
+		FrameArena m_FrameArena;
+		ItemMemory m_ItemMemory;
+
+		std::vector<HouseInfo> m_HousesInFov{};
+		std::vector<EntityInfo> m_EntitiesInFov{};
+		AgentInfo m_AgentInfo{};
+
+		Elite::Blackboard m_Blackboard{};
+	};
+
+	// The tree of the agent, once loaded from BehaviorTree.txt and once compiled from BT_Trees::Default
+	void BenchmarkAgentBehaviorTree(MicroBenchmarks& benchmarks)
+	{
+		Elite::BehaviorArena arena{};
+		BehaviorTreeLoader loader{ "BehaviorTree.txt" };
+		BT_Registry::RegisterBehaviors(loader);
+
+		Elite::IBehavior* pRuntimeTree{ loader.Load(arena) };
+		if (!pRuntimeTree)
+		{
+			std::cout << "BehaviorTree.txt is missing, the agent trees are not compared\n";
+			return;
+		}
+		Elite::StaticBehavior<BT_Trees::Default> staticTree{};
+
+		// An empty world when the level is missing
+		LevelFile level{};
+		level.Load("GameLevel.gppl");
+
+		// Both trees play the same game, they have to make the same decision every frame
+		constexpr int nrCheckedFrames{ 3600 };
+		BehaviorWorld runtimeWorld{ level };
+		BehaviorWorld staticWorld{ level };
+		int nrDifferentFrames{};
+		for (int i{}; i < nrCheckedFrames; ++i)
+		{
+			if (runtimeWorld.Tick(*pRuntimeTree) != staticWorld.Tick(staticTree)) ++nrDifferentFrames;
+		}
+		if (nrDifferentFrames > 0)
+		{
+			std::cout << "The static tree differs from BehaviorTree.txt in " << nrDifferentFrames << " of " << nrCheckedFrames << " frames\n";
+		}
+
+		// Both trees are measured on the same frame
+		Elite::Blackboard* pRuntimeBlackboard{ runtimeWorld.GetBlackboard() };
+		benchmarks.Measure("BehaviorTree/Agent", 1000, [pRuntimeTree, pRuntimeBlackboard]()
+			{
+				return pRuntimeTree->Execute(pRuntimeBlackboard);
+			});
+
+		Elite::Blackboard* pStaticBlackboard{ staticWorld.GetBlackboard() };
+		benchmarks.Measure("StaticBehaviorTree/Agent", 1000, [pStaticTree = &staticTree, pStaticBlackboard]()
+			{
+				return pStaticTree->Execute(pStaticBlackboard);
+			});
+	}
+
+	// The agent turns in place, every call discovers the tiles of another fov cone
+	void BenchmarkExplorer(MicroBenchmarks& benchmarks)
+	{
+		const WorldInfo worldInfo{ Elite::Vector2{}, Elite::Vector2{ 500.0f, 500.0f } };
+
+		for (float fovRange : { 20.0f, 60.0f, 200.0f })
+		{
+			WorldExplorer* pExplorer{ new WorldExplorer{ worldInfo } };
+
+			AgentInfo agentInfo{};
+			agentInfo.FOV_Range = fovRange;
+			agentInfo.FOV_Angle = static_cast<float>(E_PI) / 2.0f;
+
+			benchmarks.Measure("WorldExplorer/Update/" + std::to_string(static_cast<int>(fovRange)), 10000, [pExplorer, agentInfo]() mutable
+				{
+					agentInfo.Orientation += 0.1f;
+					pExplorer->Update(agentInfo);
+					return pExplorer->HasTarget();
+				});
+
+			delete pExplorer;
+		}
+
+		// A whole search for the next target, half of the world is discovered in stripes
+		WorldExplorer* pExplorer{ new WorldExplorer{ worldInfo } };
+		AgentInfo agentInfo{};
+		agentInfo.FOV_Range = 20.0f;
+		agentInfo.FOV_Angle = static_cast<float>(E_PI) / 2.0f;
+		for (float x{ -250.0f }; x < 250.0f; x += 40.0f)
+		{
+			for (float y{ -250.0f }; y < 250.0f; y += 5.0f)
+			{
+				agentInfo.Position = Elite::Vector2{ x, y };
+				pExplorer->Update(agentInfo);
+			}
+		}
+
+		benchmarks.Measure("WorldExplorer/Search", 100, [pExplorer]()
+			{
+				pExplorer->StartSearch(Elite::Vector2{});
+				while (!pExplorer->StepSearch()) {}
+				return pExplorer->HasTarget();
+			});
+
+		delete pExplorer;
+	}
+
+	// Finds the few undiscovered cells left in a grid, cell by cell and by skipping discovered blocks
+	void BenchmarkDiscoveryPyramid(MicroBenchmarks& benchmarks)
+	{
+		std::mt19937 random{ 0 };
+
+		for (int size : { 51, 512 })
+		{
+			// About one cell in a thousand is left undiscovered
+			DiscoveryPyramid* pUndiscovered{ new DiscoveryPyramid{ size } };
+			std::uniform_int_distribution<int> cellDistribution{ 0, 999 };
+			for (int y{}; y < size; ++y)
+			{
+				for (int x{}; x < size; ++x)
+				{
+					if (cellDistribution(random) != 0) pUndiscovered->Set(x, y);
+				}
+			}
+
+			benchmarks.Measure("Discovery/Scan/" + std::to_string(size), 100, [pUndiscovered, size]()
+				{
+					int nrUndiscovered{};
+					for (int y{}; y < size; ++y)
+					{
+						for (int x{}; x < size; ++x)
+						{
+							if (!pUndiscovered->Get(x, y)) ++nrUndiscovered;
+						}
+					}
+					return nrUndiscovered;
+				});
+
+			benchmarks.Measure("Discovery/Pyramid/" + std::to_string(size), 100, [pUndiscovered, size]()
+				{
+					int nrUndiscovered{};
+					pUndiscovered->ForEachUndiscovered(0, 0, size - 1, size - 1, [&nrUndiscovered](int, int) { ++nrUndiscovered; });
+					return nrUndiscovered;
+				});
+
+			delete pUndiscovered;
+		}
+	}
+
+	void BenchmarkConditions(MicroBenchmarks& benchmarks)
+	{
+		// The agent stands in the middle of an empty world
+		const LevelFile level{};
+		HeadlessInterface world{ level, 0, 0, 0 };
+		IExamInterface* pInterface{ &world };
+
+		std::mt19937 random{ 0 };
+		std::uniform_real_distribution<float> positionDistribution{ -150.0f, 150.0f };
+
+		for (int nrEntities : { 10, 100, 1000 })
+		{
+			std::vector<EntityInfo> entitiesInFov{};
+			ItemMemory itemMemory{ static_cast<size_t>(nrEntities) };
+			std::vector<HouseInfo> housesInFov{};
+			HouseRegistry houses{ WorldInfo{ Elite::Vector2{}, Elite::Vector2{ 300.0f, 300.0f } } };
+
+			// Every item in the fov is remembered, so IsLootAlreadySeen looks up every one of them
+			for (int i{}; i < nrEntities; ++i)
+			{
+				entitiesInFov.push_back(EntityInfo{ eEntityType::ITEM, Elite::Vector2{ positionDistribution(random), positionDistribution(random) }, i });
+			}
+			for (auto it{ entitiesInFov.rbegin() }; it != entitiesInFov.rend(); ++it)
+			{
+				FoundEntityInfo entity{};
+				entity.Type = eEntityType::ITEM;
+				entity.Location = it->Location;
+				entity.EntityHash = it->EntityHash;
+				itemMemory.Add(entity);
+			}
+
+			// Every house in the fov is already seen, the worst case for IsNewHouseInFOV
+			for (int i{}; i < nrEntities; ++i)
+			{
+				const HouseInfo house{ Elite::Vector2{ positionDistribution(random), positionDistribution(random) }, Elite::Vector2{ 10.0f, 10.0f } };
+				houses.MarkVisited(houses.Add(house), 0.0f);
+				housesInFov.push_back(house);
+			}
+
+			Perception perception{};
+			perception.Update(entitiesInFov, pInterface->Agent_GetInfo().Position, houses);
+
+			Elite::Blackboard blackboard{};
+			blackboard.AddData("Interface", pInterface);
+			blackboard.AddData("Perception", &perception);
+			blackboard.AddData("EntityFovVec", &entitiesInFov);
+			blackboard.AddData("ItemMemory", &itemMemory);
+			blackboard.AddData("HouseFovVec", &housesInFov);
+			blackboard.AddData("Houses", &houses);
+			blackboard.AddData("CurHouse", CurrentHouse{});
+			blackboard.AddData("HouseTarget", Elite::Vector2{});
+			blackboard.AddData("EntityTarget", Elite::Vector2{});
+			Elite::Blackboard* pBlackboard{ &blackboard };
+
+			// The conditions are quadratic, keep the total time of a sample about the same
+			const int nrCalls{ 100000 / (nrEntities * nrEntities) + 1 };
+
+			Perception* pPerception{ &perception };
+			const std::vector<EntityInfo>* pEntitiesInFov{ &entitiesInFov };
+			const HouseRegistry* pHouses{ &houses };
+			benchmarks.Measure("Perception/Update/" + std::to_string(nrEntities), 100000 / nrEntities, [pPerception, pEntitiesInFov, pHouses]()
+				{
+					pPerception->Update(*pEntitiesInFov, Elite::Vector2{}, *pHouses);
+					return pPerception->GetItems().size();
+				});
+
+			benchmarks.Measure("HouseRegistry/GetHouseAt/" + std::to_string(nrEntities), 10000, [pHouses, &positionDistribution, &random]()
+				{
+					return pHouses->GetHouseAt(Elite::Vector2{ positionDistribution(random), positionDistribution(random) });
+				});
+
+			benchmarks.Measure("Conditions/IsLootAlreadySeen/" + std::to_string(nrEntities), nrCalls, [pBlackboard]()
+				{
+					return BT_Conditions::IsLootAlreadySeen(pBlackboard);
+				});
+
+			benchmarks.Measure("Conditions/IsNewHouseInFOV/" + std::to_string(nrEntities), nrCalls, [pBlackboard]()
+				{
+					return BT_Conditions::IsNewHouseInFOV(pBlackboard);
+				});
+		}
+	}
+}
+
+// Usage: GPP_MicroBenchmark [output file] [name filter]
+int main(int argc, char* argv[])
+{
+	const std::string outputFile{ argc > 1 ? argv[1] : "MicroBenchmarkResults.json" };
+	const std::string filter{ argc > 2 ? argv[2] : "" };
+
+	MicroBenchmarks benchmarks{ filter };
+
+	BenchmarkBlackboard(benchmarks);
+	BenchmarkFrameArena(benchmarks);
+	BenchmarkBehaviorTree(benchmarks);
+	BenchmarkAgentBehaviorTree(benchmarks);
+	BenchmarkExplorer(benchmarks);
+	BenchmarkDiscoveryPyramid(benchmarks);
+	BenchmarkConditions(benchmarks);
+
+	benchmarks.WriteResults(outputFile);
+	std::cout << "Wrote the results to " << outputFile << "\n";
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include "stdafx.h"
+#include "BitGrid.h"
+
+BitGrid::BitGrid(int size)
+	: m_Size{ size }
+	, m_WordsPerRow{ (size + 63) / 64 }
+{
+	m_Words.resize(static_cast<size_t>(m_WordsPerRow) * size);
+}
+
+bool BitGrid::Get(int x, int y) const
+{
+	return (GetWord(x, y) >> (x % 64)) & 1;
+}
+
+void BitGrid::Set(int x, int y)
+{
+	GetWord(x, y) |= uint64_t{ 1 } << (x % 64);
+}
+
+void BitGrid::Reset(int x, int y)
+{
+	GetWord(x, y) &= ~(uint64_t{ 1 } << (x % 64));
+}
+
+void BitGrid::SetRun(int y, int firstX, int lastX)
+{
+	uint64_t* pRow{ &m_Words[static_cast<size_t>(y) * m_WordsPerRow] };
+	for (int word{ firstX / 64 }; word <= lastX / 64; ++word)
+	{
+		pRow[word] |= GetRunMask(word, firstX, lastX);
+	}
+}
+
+void BitGrid::ResetRun(int y, int firstX, int lastX)
+{
+	uint64_t* pRow{ &m_Words[static_cast<size_t>(y) * m_WordsPerRow] };
+	for (int word{ firstX / 64 }; word <= lastX / 64; ++word)
+	{
+		pRow[word] &= ~GetRunMask(word, firstX, lastX);
+	}
+}
+
+void BitGrid::Clear()
+{
+	std::fill(m_Words.begin(), m_Words.end(), uint64_t{});
+}
+
+int BitGrid::GetSize() const
+{
+	return m_Size;
+}
+
+uint64_t& BitGrid::GetWord(int x, int y)
+{
+	return m_Words[static_cast<size_t>(y) * m_WordsPerRow + x / 64];
+}
+
+const uint64_t& BitGrid::GetWord(int x, int y) const
+{
+	return m_Words[static_cast<size_t>(y) * m_WordsPerRow + x / 64];
+}
+
+uint64_t BitGrid::GetRunMask(int word, int firstX, int lastX)
+{
+	// Clamp the run to the 64 cells of this word
+	const int firstBit{ std::max(firstX - word * 64, 0) };
+	const int lastBit{ std::min(lastX - word * 64, 63) };
+
+	const uint64_t fromFirst{ ~uint64_t{} << firstBit };
+	const uint64_t toLast{ ~uint64_t{} >> (63 - lastBit) };
+	return fromFirst & toLast;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// A square grid with one bit per cell
+// Every row is stored in 64 bit words, so a run of cells is set or cleared with one operation per 64 cells
+class BitGrid final
+{
+public:
+	explicit BitGrid(int size);
+
+	bool Get(int x, int y) const;
+	void Set(int x, int y);
+	void Reset(int x, int y);
+
+	// Sets the cells from firstX up to and including lastX of the row
+	void SetRun(int y, int firstX, int lastX);
+	// Also calls the function with the x of every cell of the run that was not set yet
+	template<typename Function>
+	void SetRun(int y, int firstX, int lastX, Function&& onNewCell);
+	void ResetRun(int y, int firstX, int lastX);
+
+	void Clear();
+	int GetSize() const;
+private:
+	uint64_t& GetWord(int x, int y);
+	const uint64_t& GetWord(int x, int y) const;
+	// The bits of the run that lie in this word of the row
+	static uint64_t GetRunMask(int word, int firstX, int lastX);
+
+	int m_Size{};
+	int m_WordsPerRow{};
+	std::vector<uint64_t> m_Words{};
+};
+
+template<typename Function>
+void BitGrid::SetRun(int y, int firstX, int lastX, Function&& onNewCell)
+{
+	uint64_t* pRow{ &m_Words[static_cast<size_t>(y) * m_WordsPerRow] };
+	for (int word{ firstX / 64 }; word <= lastX / 64; ++word)
+	{
+		const uint64_t runMask{ GetRunMask(word, firstX, lastX) };
+		uint64_t newBits{ runMask & ~pRow[word] };
+		pRow[word] |= runMask;
+
+		// Only the bits that changed are visited, the lowest one is cleared every iteration
+		while (newBits)
+		{
+			onNewCell(word * 64 + std::countr_zero(newBits));
+			newBits &= newBits - 1;
+		}
+	}
+}
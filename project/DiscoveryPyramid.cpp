@@ -0,0 +1,90 @@
+#include "stdafx.h"
+#include "DiscoveryPyramid.h"
+
+DiscoveryPyramid::DiscoveryPyramid(int size)
+	: m_Cells{ size }
+{
+	// Enough levels to end in one block that covers the whole grid
+	while ((1 << m_NrLevels) < size) ++m_NrLevels;
+
+	m_Levels.resize(m_NrLevels);
+	for (int level{ 1 }; level <= m_NrLevels; ++level)
+	{
+		const int levelSize{ 1 << (m_NrLevels - level) };
+		m_Levels[level - 1].resize(static_cast<size_t>(levelSize) * levelSize);
+	}
+
+	Clear();
+}
+
+bool DiscoveryPyramid::Get(int x, int y) const
+{
+	return m_Cells.Get(x, y);
+}
+
+void DiscoveryPyramid::Set(int x, int y)
+{
+	if (m_Cells.Get(x, y)) return;
+
+	m_Cells.Set(x, y);
+	OnDiscovered(x, y);
+}
+
+void DiscoveryPyramid::SetRun(int y, int firstX, int lastX)
+{
+	m_Cells.SetRun(y, firstX, lastX, [this, y](int x) { OnDiscovered(x, y); });
+}
+
+void DiscoveryPyramid::Clear()
+{
+	m_Cells.Clear();
+
+	// Every block counts the cells it covers that lie inside of the grid
+	const int size{ m_Cells.GetSize() };
+	for (int level{ 1 }; level <= m_NrLevels; ++level)
+	{
+		const int levelSize{ 1 << (m_NrLevels - level) };
+		const int blockSize{ 1 << level };
+		for (int blockY{}; blockY < levelSize; ++blockY)
+		{
+			const int height{ std::clamp(size - blockY * blockSize, 0, blockSize) };
+			for (int blockX{}; blockX < levelSize; ++blockX)
+			{
+				const int width{ std::clamp(size - blockX * blockSize, 0, blockSize) };
+				m_Levels[level - 1][blockY * levelSize + blockX] = width * height;
+			}
+		}
+	}
+}
+
+int DiscoveryPyramid::GetSize() const
+{
+	return m_Cells.GetSize();
+}
+
+const BitGrid& DiscoveryPyramid::GetCells() const
+{
+	return m_Cells;
+}
+
+int DiscoveryPyramid::GetCount(int level, int blockX, int blockY) const
+{
+	// The cells themselves, the ones outside of the grid count as discovered
+	if (level == 0)
+	{
+		const bool isInGrid{ blockX < m_Cells.GetSize() && blockY < m_Cells.GetSize() };
+		return isInGrid && !m_Cells.Get(blockX, blockY) ? 1 : 0;
+	}
+
+	const int levelSize{ 1 << (m_NrLevels - level) };
+	return m_Levels[level - 1][blockY * levelSize + blockX];
+}
+
+void DiscoveryPyramid::OnDiscovered(int x, int y)
+{
+	for (int level{ 1 }; level <= m_NrLevels; ++level)
+	{
+		const int levelSize{ 1 << (m_NrLevels - level) };
+		--m_Levels[level - 1][(y >> level) * levelSize + (x >> level)];
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include "BitGrid.h"
+
+// The discovered cells of a square grid, with a pyramid of undiscovered counts above them
+// Every level halves the size of the one below, a block counts the undiscovered cells of the four blocks under it
+// Queries start at the single block on top and skip every block that is fully discovered,
+// so their cost depends on the undiscovered cells they find instead of on the size of the grid
+class DiscoveryPyramid final
+{
+public:
+	explicit DiscoveryPyramid(int size);
+
+	bool Get(int x, int y) const;
+	// Discovering keeps the counts up to date, every new cell updates one block per level
+	void Set(int x, int y);
+	void SetRun(int y, int firstX, int lastX);
+	void Clear();
+
+	int GetSize() const;
+	const BitGrid& GetCells() const;
+
+	// Calls the function with the x and y of every undiscovered cell from min up to and including max
+	template<typename Function>
+	void ForEachUndiscovered(int minX, int minY, int maxX, int maxY, Function&& function) const;
+private:
+	int GetCount(int level, int blockX, int blockY) const;
+	void OnDiscovered(int x, int y);
+	template<typename Function>
+	void VisitUndiscovered(int level, int blockX, int blockY, int minX, int minY, int maxX, int maxY, Function& function) const;
+
+	BitGrid m_Cells;
+	// The levels are a power of two wide, the cells outside of the grid count as discovered
+	int m_NrLevels{};
+	// Level 1 up to and including the single block on top, the cells themselves are level 0
+	std::vector<std::vector<int>> m_Levels{};
+};
+
+template<typename Function>
+void DiscoveryPyramid::ForEachUndiscovered(int minX, int minY, int maxX, int maxY, Function&& function) const
+{
+	VisitUndiscovered(m_NrLevels, 0, 0, minX, minY, maxX, maxY, function);
+}
+
+template<typename Function>
+void DiscoveryPyramid::VisitUndiscovered(int level, int blockX, int blockY, int minX, int minY, int maxX, int maxY, Function& function) const
+{
+	// The cells this block covers
+	const int firstX{ blockX << level };
+	const int firstY{ blockY << level };
+	const int lastX{ ((blockX + 1) << level) - 1 };
+	const int lastY{ ((blockY + 1) << level) - 1 };
+	if (lastX < minX || lastY < minY || firstX > maxX || firstY > maxY) return;
+
+	// Nothing is left to find below a discovered block
+	if (GetCount(level, blockX, blockY) == 0) return;
+
+	if (level == 0)
+	{
+		function(firstX, firstY);
+		return;
+	}
+
+	for (int childY{ blockY * 2 }; childY <= blockY * 2 + 1; ++childY)
+	{
+		for (int childX{ blockX * 2 }; childX <= blockX * 2 + 1; ++childX)
+		{
+			VisitUndiscovered(level - 1, childX, childY, minX, minY, maxX, maxY, function);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EBehaviorArena.h"
+using namespace Elite;
+
+BehaviorArena::BehaviorArena(size_t blockSize)
+	: m_BlockSize{ blockSize }
+{
+	// Reserve the first block up front, a whole tree normally fits in it
+	AddBlock(m_BlockSize);
+}
+
+BehaviorArena::~BehaviorArena()
+{
+	// Destroy every object
+	Clear();
+
+	// Release the first block
+	free(m_pFirstBlock);
+}
+
+void* BehaviorArena::Allocate(size_t size, size_t alignment)
+{
+	// Align the current pointer
+	const uintptr_t current{ reinterpret_cast<uintptr_t>(m_pCurrent) };
+	const uintptr_t aligned{ (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1) };
+
+	// If the allocation does not fit in the current block, start a new block
+	if (aligned + size > reinterpret_cast<uintptr_t>(m_pEnd))
+	{
+		AddBlock(size + alignment);
+		return Allocate(size, alignment);
+	}
+
+	// Move the current pointer past the allocation
+	m_pCurrent = reinterpret_cast<char*>(aligned + size);
+	m_UsedSize += size;
+
+	return reinterpret_cast<void*>(aligned);
+}
+
+void BehaviorArena::Clear()
+{
+	// Destroy all objects in the reverse order of creation
+	for (Destructor* pDestructor{ m_pLastDestructor }; pDestructor; pDestructor = pDestructor->pPrevious)
+	{
+		pDestructor->fpDestroy(pDestructor->pObject);
+	}
+	m_pLastDestructor = nullptr;
+
+	// Release every block except the first one
+	Block* pBlock{ m_pFirstBlock->pNext };
+	while (pBlock)
+	{
+		Block* pNext{ pBlock->pNext };
+		free(pBlock);
+		pBlock = pNext;
+	}
+
+	// Rewind to the start of the first block
+	m_pFirstBlock->pNext = nullptr;
+	m_pCurrentBlock = m_pFirstBlock;
+	m_pCurrent = reinterpret_cast<char*>(m_pFirstBlock + 1);
+	m_pEnd = reinterpret_cast<char*>(m_pFirstBlock + 1) + m_pFirstBlock->size;
+	m_NrBlocks = 1;
+	m_UsedSize = 0;
+}
+
+void BehaviorArena::AddDestructor(void* pObject, void (*fpDestroy)(void*))
+{
+	Destructor* pDestructor{ static_cast<Destructor*>(Allocate(sizeof(Destructor), alignof(Destructor))) };
+	pDestructor->pPrevious = m_pLastDestructor;
+	pDestructor->pObject = pObject;
+	pDestructor->fpDestroy = fpDestroy;
+
+	m_pLastDestructor = pDestructor;
+}
+
+void BehaviorArena::AddBlock(size_t minimumSize)
+{
+	// Allocate the block header together with its memory
+	const size_t size{ minimumSize > m_BlockSize ? minimumSize : m_BlockSize };
+	Block* pBlock{ static_cast<Block*>(malloc(sizeof(Block) + size)) };
+	if (!pBlock) throw std::bad_alloc{};
+
+	pBlock->pNext = nullptr;
+	pBlock->size = size;
+
+	// Link the block after the current block
+	if (m_pCurrentBlock) m_pCurrentBlock->pNext = pBlock;
+	else m_pFirstBlock = pBlock;
+
+	m_pCurrentBlock = pBlock;
+	m_pCurrent = reinterpret_cast<char*>(pBlock + 1);
+	m_pEnd = m_pCurrent + size;
+	++m_NrBlocks;
+}
@@ -0,0 +1,103 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EBehaviorArena.h: Linear allocator that owns every node of a behavior tree
+/*=============================================================================*/
+#ifndef ELITE_BEHAVIOR_ARENA
+#define ELITE_BEHAVIOR_ARENA
+
+//--- Includes ---
+#include <initializer_list>
+#include <type_traits>
+
+namespace Elite
+{
+	class IBehavior;
+
+	//-----------------------------------------------------------------
+	// BEHAVIOR ARENA
+	//-----------------------------------------------------------------
+	//Nodes and child lists are placed next to each other in one block of memory.
+	//The arena owns everything it creates: destroying it destroys the whole tree at once.
+	class BehaviorArena final
+	{
+	public:
+		explicit BehaviorArena(size_t blockSize = 16 * 1024);
+		~BehaviorArena();
+
+		BehaviorArena(const BehaviorArena& other) = delete;
+		BehaviorArena& operator=(const BehaviorArena& other) = delete;
+		BehaviorArena(BehaviorArena&& other) = delete;
+		BehaviorArena& operator=(BehaviorArena&& other) = delete;
+
+		//Construct an object inside the arena
+		template<typename T, typename... Args> T* Create(Args&&... args)
+		{
+			T* pObject{ new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...) };
+
+			//Only remember objects that need their destructor to be called
+			if (!std::is_trivially_destructible<T>::value)
+			{
+				AddDestructor(pObject, [](void* p) { static_cast<T*>(p)->~T(); });
+			}
+
+			return pObject;
+		}
+
+		//Construct a composite behavior, its child list is stored inside the arena
+		template<typename T> T* CreateComposite(std::initializer_list<IBehavior*> childBehaviors)
+		{
+			return CreateComposite<T>(childBehaviors.begin(), static_cast<unsigned int>(childBehaviors.size()));
+		}
+		template<typename T> T* CreateComposite(IBehavior* const* pChildBehaviors, unsigned int nrChildBehaviors)
+		{
+			IBehavior** pArenaChildBehaviors{ static_cast<IBehavior**>(Allocate(sizeof(IBehavior*) * nrChildBehaviors, alignof(IBehavior*))) };
+
+			for (unsigned int i{}; i < nrChildBehaviors; ++i)
+			{
+				pArenaChildBehaviors[i] = pChildBehaviors[i];
+			}
+
+			return Create<T>(pArenaChildBehaviors, nrChildBehaviors);
+		}
+
+		//Raw memory from the arena, released together with the arena
+		void* Allocate(size_t size, size_t alignment);
+
+		//Destroy every object and rewind the arena, the first block is kept for reuse
+		void Clear();
+
+		size_t GetUsedSize() const { return m_UsedSize; }
+		size_t GetNrBlocks() const { return m_NrBlocks; }
+
+	private:
+		struct Block
+		{
+			Block* pNext;
+			size_t size;
+		};
+
+		//Destructors are stored in the arena as well, newest first
+		struct Destructor
+		{
+			Destructor* pPrevious;
+			void* pObject;
+			void (*fpDestroy)(void*);
+		};
+
+		void AddDestructor(void* pObject, void (*fpDestroy)(void*));
+		void AddBlock(size_t minimumSize);
+
+		const size_t m_BlockSize{};
+
+		Block* m_pFirstBlock{};
+		Block* m_pCurrentBlock{};
+		char* m_pCurrent{};
+		char* m_pEnd{};
+		size_t m_NrBlocks{};
+		size_t m_UsedSize{};
+
+		Destructor* m_pLastDestructor{};
+	};
+}
+#endif
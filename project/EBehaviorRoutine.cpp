@@ -0,0 +1,77 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EBehaviorRoutine.h"
+using namespace Elite;
+
+//-----------------------------------------------------------------
+// BEHAVIOR ROUTINE POOL
+//-----------------------------------------------------------------
+BehaviorRoutinePool::~BehaviorRoutinePool()
+{
+	// Every routine is finished or destroyed by now, so every frame is free
+	while (m_pFreeFrames)
+	{
+		FrameHeader* pNext{ m_pFreeFrames->pNextFree };
+		free(m_pFreeFrames);
+		m_pFreeFrames = pNext;
+	}
+}
+
+void* BehaviorRoutinePool::Allocate(size_t size)
+{
+	// Reuse the smallest free frame that is big enough, a tree only has a few different routines
+	FrameHeader** ppBestFrame{};
+	for (FrameHeader** ppFrame{ &m_pFreeFrames }; *ppFrame; ppFrame = &(*ppFrame)->pNextFree)
+	{
+		if ((*ppFrame)->capacity < size) continue;
+		if (!ppBestFrame || (*ppFrame)->capacity < (*ppBestFrame)->capacity) ppBestFrame = ppFrame;
+	}
+
+	FrameHeader* pHeader{};
+	if (ppBestFrame)
+	{
+		pHeader = *ppBestFrame;
+		*ppBestFrame = pHeader->pNextFree;
+	}
+	else
+	{
+		pHeader = static_cast<FrameHeader*>(malloc(sizeof(FrameHeader) + size));
+		if (!pHeader) throw std::bad_alloc{};
+
+		pHeader->pPool = this;
+		pHeader->capacity = size;
+		++m_NrFrames;
+	}
+
+	// The frame starts right after its header
+	pHeader->pNextFree = nullptr;
+	return pHeader + 1;
+}
+
+void BehaviorRoutinePool::Deallocate(void* pFrame)
+{
+	FrameHeader* pHeader{ static_cast<FrameHeader*>(pFrame) - 1 };
+	BehaviorRoutinePool* pPool{ pHeader->pPool };
+
+	pHeader->pNextFree = pPool->m_pFreeFrames;
+	pPool->m_pFreeFrames = pHeader;
+}
+
+//-----------------------------------------------------------------
+// BEHAVIOR COROUTINE (IBehavior)
+//-----------------------------------------------------------------
+BehaviorState BehaviorCoroutine::Execute(Blackboard* pBlackBoard)
+{
+	if (m_fpRoutine == nullptr || m_pPool == nullptr)
+		return BehaviorState::Failure;
+
+	// Start the routine when it is not running yet
+	if (!m_Routine) m_Routine = m_fpRoutine(*m_pPool, pBlackBoard);
+
+	m_CurrentState = m_Routine.Resume();
+
+	// A finished routine gives its frame back to the pool
+	if (m_Routine.IsDone()) m_Routine = BehaviorRoutine{};
+
+	return m_CurrentState;
+}
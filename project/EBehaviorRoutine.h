@@ -0,0 +1,127 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EBehaviorRoutine.h: Behaviors that run over multiple frames as a coroutine
+/*=============================================================================*/
+#ifndef ELITE_BEHAVIOR_ROUTINE
+#define ELITE_BEHAVIOR_ROUTINE
+
+//--- Includes ---
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include "EBehaviorTree.h"
+
+namespace Elite
+{
+	//-----------------------------------------------------------------
+	// BEHAVIOR ROUTINE POOL
+	//-----------------------------------------------------------------
+	//Keeps the frames of finished routines, so restarting a routine does not allocate.
+	//Every tree owns one pool, it has to outlive every routine that was allocated from it.
+	class BehaviorRoutinePool final
+	{
+	public:
+		BehaviorRoutinePool() = default;
+		~BehaviorRoutinePool();
+
+		BehaviorRoutinePool(const BehaviorRoutinePool& other) = delete;
+		BehaviorRoutinePool& operator=(const BehaviorRoutinePool& other) = delete;
+		BehaviorRoutinePool(BehaviorRoutinePool&& other) = delete;
+		BehaviorRoutinePool& operator=(BehaviorRoutinePool&& other) = delete;
+
+		void* Allocate(size_t size);
+		//The frame knows its pool, so it can be returned without one
+		static void Deallocate(void* pFrame);
+
+		size_t GetNrFrames() const { return m_NrFrames; }
+
+	private:
+		struct alignas(std::max_align_t) FrameHeader
+		{
+			BehaviorRoutinePool* pPool;
+			FrameHeader* pNextFree;
+			size_t capacity;
+		};
+
+		FrameHeader* m_pFreeFrames{};
+		size_t m_NrFrames{};
+	};
+
+	//-----------------------------------------------------------------
+	// BEHAVIOR ROUTINE
+	//-----------------------------------------------------------------
+	//The result of a routine, a coroutine that takes the pool and the blackboard:
+	//	BehaviorRoutine LookAround(BehaviorRoutinePool& pool, Blackboard* pBlackboard)
+	//'co_yield BehaviorState::Running' ends the frame, 'co_return' ends the routine with Success or Failure.
+	//Local variables of the routine keep their value between frames.
+	class BehaviorRoutine final
+	{
+	public:
+		struct promise_type
+		{
+			BehaviorState state{ BehaviorState::Running };
+
+			//The frame of the coroutine lives in the pool that is passed as its first argument
+			static void* operator new(size_t size, BehaviorRoutinePool& pool, Blackboard*) { return pool.Allocate(size); }
+			static void operator delete(void* pFrame) { BehaviorRoutinePool::Deallocate(pFrame); }
+
+			BehaviorRoutine get_return_object() { return BehaviorRoutine{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			std::suspend_always yield_value(BehaviorState yieldedState) noexcept { state = yieldedState; return {}; }
+			void return_value(BehaviorState returnedState) noexcept { state = returnedState; }
+			void unhandled_exception() { std::terminate(); }
+		};
+
+		BehaviorRoutine() = default;
+		~BehaviorRoutine() { if (m_Handle) m_Handle.destroy(); }
+
+		BehaviorRoutine(const BehaviorRoutine& other) = delete;
+		BehaviorRoutine& operator=(const BehaviorRoutine& other) = delete;
+		BehaviorRoutine(BehaviorRoutine&& other) noexcept : m_Handle{ other.m_Handle } { other.m_Handle = nullptr; }
+		BehaviorRoutine& operator=(BehaviorRoutine&& other) noexcept
+		{
+			if (this == &other) return *this;
+			if (m_Handle) m_Handle.destroy();
+			m_Handle = other.m_Handle;
+			other.m_Handle = nullptr;
+			return *this;
+		}
+
+		//Runs the routine until it yields or returns
+		BehaviorState Resume()
+		{
+			m_Handle.resume();
+			return m_Handle.promise().state;
+		}
+		bool IsDone() const { return m_Handle.done(); }
+		explicit operator bool() const { return static_cast<bool>(m_Handle); }
+
+	private:
+		explicit BehaviorRoutine(std::coroutine_handle<promise_type> handle) : m_Handle{ handle } {}
+
+		std::coroutine_handle<promise_type> m_Handle{};
+	};
+
+	using BehaviorRoutineFunction = BehaviorRoutine(*)(BehaviorRoutinePool&, Blackboard*);
+
+	//-----------------------------------------------------------------
+	// BEHAVIOR COROUTINE (IBehavior)
+	//-----------------------------------------------------------------
+	//Starts the routine when it is not running and resumes it once per execution.
+	//A routine that is not executed keeps its place, like a partial sequence.
+	class BehaviorCoroutine final : public IBehavior
+	{
+	public:
+		explicit BehaviorCoroutine(BehaviorRoutinePool* pPool, BehaviorRoutineFunction fpRoutine)
+			: m_pPool(pPool), m_fpRoutine(fpRoutine) {}
+		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
+
+	private:
+		BehaviorRoutinePool* m_pPool = nullptr;
+		BehaviorRoutineFunction m_fpRoutine = nullptr;
+		BehaviorRoutine m_Routine{};
+	};
+}
+#endif
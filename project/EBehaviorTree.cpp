@@ -10,9 +10,11 @@ using namespace Elite;
 //SELECTOR
 BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 {
-	// Loop over all children in m_ChildBehaviors
-	for (auto& child : m_ChildBehaviors)
+	// Loop over all children in m_pChildBehaviors
+	for (unsigned int i = 0; i < m_NrChildBehaviors; ++i)
 	{
+		IBehavior* child = m_pChildBehaviors[i];
+
 		//Every Child: Execute and store the result in m_CurrentState
 		m_CurrentState = child->Execute(pBlackBoard);
 
@@ -34,9 +36,11 @@ BehaviorState BehaviorSelector::Execute(Blackboard* pBlackBoard)
 //SEQUENCE
 BehaviorState BehaviorSequence::Execute(Blackboard* pBlackBoard)
 {
-	// Loop over all children in m_ChildBehaviors
-	for (auto& child : m_ChildBehaviors)
+	// Loop over all children in m_pChildBehaviors
+	for (unsigned int i = 0; i < m_NrChildBehaviors; ++i)
 	{
+		IBehavior* child = m_pChildBehaviors[i];
+
 		//Every Child: Execute and store the result in m_CurrentState
 		m_CurrentState = child->Execute(pBlackBoard);
 
@@ -58,9 +62,9 @@ BehaviorState BehaviorSequence::Execute(Blackboard* pBlackBoard)
 //PARTIAL SEQUENCE
 BehaviorState BehaviorPartialSequence::Execute(Blackboard* pBlackBoard)
 {
-	while (m_CurrentBehaviorIndex < m_ChildBehaviors.size())
+	while (m_CurrentBehaviorIndex < m_NrChildBehaviors)
 	{
-		m_CurrentState = m_ChildBehaviors[m_CurrentBehaviorIndex]->Execute(pBlackBoard);
+		m_CurrentState = m_pChildBehaviors[m_CurrentBehaviorIndex]->Execute(pBlackBoard);
 		switch (m_CurrentState)
 		{
 		case BehaviorState::Failure:
@@ -82,8 +86,8 @@ BehaviorState BehaviorPartialSequence::Execute(Blackboard* pBlackBoard)
 //INVERTOR
 BehaviorState BehaviorInvertor::Execute(Blackboard* pBlackBoard)
 {
-	// Loop over all children in m_ChildBehaviors
-	auto& child{ m_ChildBehaviors[0] };
+	// The invertor only has one child
+	auto& child{ m_pChildBehaviors[0] };
 
 	m_CurrentState = child->Execute(pBlackBoard);
 	switch (m_CurrentState)
@@ -9,6 +9,7 @@
 
 //--- Includes ---
 #include "EBlackboard.h"
+#include "EBehaviorArena.h"
 #include "EDecisionMaking.h"
 
 namespace Elite
@@ -42,32 +43,27 @@ namespace Elite
 	//-----------------------------------------------------------------
 #pragma region COMPOSITES
 	//--- COMPOSITE BASE ---
+	//The child list lives in the BehaviorArena that owns the tree, the composite never deletes its children
 	class BehaviorComposite : public IBehavior
 	{
 	public:
-		explicit BehaviorComposite(std::vector<IBehavior*> childBehaviors)
-		{ m_ChildBehaviors = childBehaviors;	}
-		virtual ~BehaviorComposite()
-		{
-			for (auto pb : m_ChildBehaviors)
-			{
-				if (pb) delete pb;
-			}
-			m_ChildBehaviors.clear();
-		}
+		explicit BehaviorComposite(IBehavior** pChildBehaviors, unsigned int nrChildBehaviors)
+			: m_pChildBehaviors(pChildBehaviors), m_NrChildBehaviors(nrChildBehaviors) {}
+		virtual ~BehaviorComposite() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override = 0;
 
 	protected:
-		std::vector<IBehavior*> m_ChildBehaviors = {};
+		IBehavior** m_pChildBehaviors = nullptr;
+		unsigned int m_NrChildBehaviors = 0;
 	};
 
 	//--- SELECTOR ---
 	class BehaviorSelector : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSelector(std::vector<IBehavior*> childBehaviors) :
-			BehaviorComposite(childBehaviors) {}
+		explicit BehaviorSelector(IBehavior** pChildBehaviors, unsigned int nrChildBehaviors) :
+			BehaviorComposite(pChildBehaviors, nrChildBehaviors) {}
 		virtual ~BehaviorSelector() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
@@ -77,8 +73,8 @@ namespace Elite
 	class BehaviorSequence : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorSequence(std::vector<IBehavior*> childBehaviors) :
-			BehaviorComposite(childBehaviors) {}
+		explicit BehaviorSequence(IBehavior** pChildBehaviors, unsigned int nrChildBehaviors) :
+			BehaviorComposite(pChildBehaviors, nrChildBehaviors) {}
 		virtual ~BehaviorSequence() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
@@ -88,8 +84,8 @@ namespace Elite
 	class BehaviorPartialSequence : public BehaviorSequence
 	{
 	public:
-		explicit BehaviorPartialSequence(std::vector<IBehavior*> childBehaviors)
-			: BehaviorSequence(childBehaviors) {}
+		explicit BehaviorPartialSequence(IBehavior** pChildBehaviors, unsigned int nrChildBehaviors)
+			: BehaviorSequence(pChildBehaviors, nrChildBehaviors) {}
 		virtual ~BehaviorPartialSequence() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
@@ -102,8 +98,8 @@ namespace Elite
 	class BehaviorInvertor : public BehaviorComposite
 	{
 	public:
-		explicit BehaviorInvertor(IBehavior* childBehaviors) :
-			BehaviorComposite({ childBehaviors }) {}
+		explicit BehaviorInvertor(IBehavior** pChildBehaviors, unsigned int nrChildBehaviors) :
+			BehaviorComposite(pChildBehaviors, nrChildBehaviors) {}
 		virtual ~BehaviorInvertor() = default;
 
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
@@ -142,11 +138,11 @@ namespace Elite
 	class BehaviorTree final : public Elite::IDecisionMaking
 	{
 	public:
-		explicit BehaviorTree(Blackboard* pBlackBoard, IBehavior* pRootBehavior)
-			: m_pBlackBoard(pBlackBoard), m_pRootBehavior(pRootBehavior) {};
+		explicit BehaviorTree(Blackboard* pBlackBoard, BehaviorArena* pArena, IBehavior* pRootBehavior)
+			: m_pBlackBoard(pBlackBoard), m_pArena(pArena), m_pRootBehavior(pRootBehavior) {};
 		~BehaviorTree()
 		{
-			if(m_pRootBehavior) delete m_pRootBehavior;
+			if(m_pArena) delete m_pArena; //Takes ownership of passed arena, this releases every node at once!
 			if(m_pBlackBoard) delete m_pBlackBoard; //Takes ownership of passed blackboard!
 		};
 
@@ -165,9 +161,18 @@ namespace Elite
 		Blackboard* GetBlackboard() const
 		{ return m_pBlackBoard;	}
 
+		//Swap in a new tree, the old arena and all of its nodes are released
+		void SetRootBehavior(BehaviorArena* pArena, IBehavior* pRootBehavior)
+		{
+			if (m_pArena) delete m_pArena;
+			m_pArena = pArena;
+			m_pRootBehavior = pRootBehavior;
+		}
+
 	private:
 		BehaviorState m_CurrentState = BehaviorState::Failure;
 		Blackboard* m_pBlackBoard = nullptr;
+		BehaviorArena* m_pArena = nullptr;
 		IBehavior* m_pRootBehavior = nullptr;
 	};
 }
@@ -9,17 +9,27 @@
 
 //Includes
 #include <unordered_map>
+#include <concepts>
 
 namespace Elite
 {
 	//-----------------------------------------------------------------
 	// BLACKBOARD TYPES (BASE)
 	//-----------------------------------------------------------------
+	//Every field counts its changes, so derived data only has to be recomputed when the version moved
 	class IBlackBoardField
 	{
 	public:
 		IBlackBoardField() = default;
 		virtual ~IBlackBoardField() = default;
+
+		unsigned int GetVersion() const { return m_Version; }
+
+	protected:
+		//Versions start at 1, so 0 can mean 'never read' for the users of a field
+		unsigned int m_Version = 1;
+
+		void OnChanged() { ++m_Version; }
 	};
 
 	//BlackboardField does not take ownership of pointers whatsoever!
@@ -30,19 +40,54 @@ namespace Elite
 		explicit BlackboardField(T data) : m_Data(data)
 		{}
 		T GetData() { return m_Data; };
-		void SetData(T data) { m_Data = data; }
+		const T& View() const { return m_Data; }
+		//The caller writes through the reference, so this always counts as a change
+		T& Modify()
+		{
+			OnChanged();
+			return m_Data;
+		}
+		void SetData(T data)
+		{
+			//Writing the same value again is not a change
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (m_Data == data) return;
+			}
+			m_Data = data;
+			OnChanged();
+		}
 
 	private:
 		T m_Data;
 	};
 
+	//A field that is looked up and type checked once, reads and writes go straight to the stored value
+	template<typename T>
+	class BlackboardHandle final
+	{
+	public:
+		BlackboardHandle() = default;
+		explicit BlackboardHandle(BlackboardField<T>* pField) : m_pField(pField)
+		{}
+
+		explicit operator bool() const { return m_pField != nullptr; }
+
+		const T& View() const { return m_pField->View(); }
+		//Counts as a change of the field, users compare the version before they read it again
+		T& Get() { return m_pField->Modify(); }
+
+	private:
+		BlackboardField<T>* m_pField = nullptr;
+	};
+
 	//-----------------------------------------------------------------
 	// BLACKBOARD (BASE)
 	//-----------------------------------------------------------------
 	class Blackboard final
 	{
 	public:
-		Blackboard() = default;
+		Blackboard() : m_Id(++m_NrCreated) {}
 		~Blackboard()
 		{
 			for (auto& el : m_BlackboardData)
@@ -98,8 +143,60 @@ namespace Elite
 			return false;
 		}
 
+		//Look up a field once, the handle is empty when the field does not exist or has another type
+		template<typename T> BlackboardHandle<T> Bind(const std::string& name)
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it != m_BlackboardData.end())
+			{
+				BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(it->second);
+				if (p) return BlackboardHandle<T>{ p };
+			}
+			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+			return BlackboardHandle<T>{};
+		}
+
+		//The version of a field, 0 when the field does not exist
+		unsigned int GetVersion(const std::string& name) const
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it == m_BlackboardData.end() || !it->second) return 0;
+			return it->second->GetVersion();
+		}
+
+		//Unique for every blackboard that was created, also when a new one reuses the memory of a deleted one
+		unsigned int GetId() const { return m_Id; }
+
 	private:
 		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+		unsigned int m_Id = 0;
+		inline static unsigned int m_NrCreated = 0;
+	};
+
+	//A handle that binds on its first use with a blackboard and keeps the binding for the next calls
+	//Meant as a static inside a node function, the lookup and type check then happen once per blackboard instead of every call
+	template<typename T>
+	class CachedBlackboardHandle final
+	{
+	public:
+		explicit CachedBlackboardHandle(const char* name) : m_Name(name)
+		{}
+
+		BlackboardHandle<T>& Bind(Blackboard* pBlackboard)
+		{
+			if (pBlackboard->GetId() != m_BlackboardId)
+			{
+				m_Handle = pBlackboard->Bind<T>(m_Name);
+				m_BlackboardId = pBlackboard->GetId();
+			}
+			return m_Handle;
+		}
+
+	private:
+		const char* m_Name = nullptr;
+		//Blackboard ids start at 1, so 0 means not bound yet
+		unsigned int m_BlackboardId = 0;
+		BlackboardHandle<T> m_Handle = {};
 	};
 }
 #endif
\ No newline at end of file
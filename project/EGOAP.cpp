@@ -0,0 +1,294 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EGOAP.h"
+#include <bitset>
+using namespace Elite;
+
+//-----------------------------------------------------------------
+// GOAP PLANNER
+//-----------------------------------------------------------------
+void GOAPPlanner::Begin(const std::vector<GOAPAction>& actions, GOAPWorldState start, GOAPWorldState goalMask, GOAPWorldState goalValues)
+{
+	m_Start = start;
+	m_GoalMask = goalMask;
+	m_GoalValues = goalValues;
+
+	//The cheapest action keeps the heuristic below the real cost
+	m_MinActionCost = FLT_MAX;
+	for (const GOAPAction& action : actions)
+	{
+		if (action.cost < m_MinActionCost) m_MinActionCost = action.cost;
+	}
+	if (actions.empty()) m_MinActionCost = 0.0f;
+
+	//Reset the search, the containers keep their memory
+	m_OpenList = {};
+	m_Records.clear();
+	m_Plan.clear();
+
+	m_Records[start] = NodeRecord{ start, static_cast<unsigned int>(-1), 0.0f, false };
+	m_OpenList.push(OpenNode{ GetHeuristic(start), start });
+
+	m_IsSearching = true;
+	m_HasPlan = false;
+}
+
+bool GOAPPlanner::Step(const std::vector<GOAPAction>& actions, unsigned int maxExpansions)
+{
+	if (!m_IsSearching) return true;
+
+	unsigned int nrExpansions = 0;
+	while (!m_OpenList.empty() && nrExpansions < maxExpansions)
+	{
+		const OpenNode node = m_OpenList.top();
+		m_OpenList.pop();
+
+		//Skip states that were already expanded through a cheaper path
+		NodeRecord& record = m_Records[node.state];
+		if (record.isClosed) continue;
+
+		//Goal reached: walk back through the parents
+		if ((node.state & m_GoalMask) == m_GoalValues)
+		{
+			BuildPlan(node.state);
+			m_HasPlan = true;
+			m_IsSearching = false;
+			return true;
+		}
+
+		record.isClosed = true;
+		++nrExpansions;
+
+		//Apply every action that can be executed in this state
+		for (unsigned int i = 0; i < actions.size(); ++i)
+		{
+			const GOAPAction& action = actions[i];
+			if ((node.state & action.preconditionMask) != action.preconditionValues) continue;
+
+			const GOAPWorldState nextState = (node.state & ~action.effectMask) | action.effectValues;
+			if (nextState == node.state) continue;
+
+			const float gCost = record.gCost + action.cost;
+
+			auto it = m_Records.find(nextState);
+			if (it == m_Records.end())
+			{
+				//Stop growing the search when it gets too big
+				if (m_Records.size() >= MaxRecords) continue;
+				it = m_Records.emplace(nextState, NodeRecord{ node.state, i, gCost, false }).first;
+			}
+			else
+			{
+				if (it->second.isClosed || gCost >= it->second.gCost) continue;
+				it->second = NodeRecord{ node.state, i, gCost, false };
+			}
+
+			m_OpenList.push(OpenNode{ gCost + GetHeuristic(nextState), nextState });
+		}
+	}
+
+	//Nothing left to search: the goal can not be reached
+	if (m_OpenList.empty())
+	{
+		m_IsSearching = false;
+		m_HasPlan = false;
+		return true;
+	}
+
+	return false;
+}
+
+float GOAPPlanner::GetHeuristic(GOAPWorldState state) const
+{
+	//Every wrong goal bit costs at least one action
+	const std::bitset<32> wrongBits{ (state ^ m_GoalValues) & m_GoalMask };
+	return static_cast<float>(wrongBits.count()) * m_MinActionCost;
+}
+
+void GOAPPlanner::BuildPlan(GOAPWorldState state)
+{
+	m_Plan.clear();
+
+	while (state != m_Start)
+	{
+		const NodeRecord& record = m_Records[state];
+		m_Plan.push_back(record.action);
+		state = record.parent;
+	}
+
+	std::reverse(m_Plan.begin(), m_Plan.end());
+}
+
+//-----------------------------------------------------------------
+// GOAP DECISION MAKER
+//-----------------------------------------------------------------
+GOAPDecisionMaker::GOAPDecisionMaker(Blackboard* pBlackBoard, BehaviorArena* pArena, unsigned int maxExpansionsPerFrame)
+	: m_pBlackBoard(pBlackBoard), m_pArena(pArena), m_MaxExpansionsPerFrame(maxExpansionsPerFrame)
+{
+}
+
+GOAPDecisionMaker::~GOAPDecisionMaker()
+{
+	if (m_pArena) delete m_pArena; //Takes ownership of passed arena, this releases every behavior
+	if (m_pBlackBoard) delete m_pBlackBoard; //Takes ownership of passed blackboard!
+}
+
+GOAPWorldState GOAPDecisionMaker::AddFact(const std::function<bool(Blackboard*)>& fpSensor)
+{
+	assert(m_Sensors.size() < 32 && "A GOAP world state can only hold 32 facts");
+
+	m_Sensors.push_back(fpSensor);
+	return GOAPWorldState(1) << (m_Sensors.size() - 1);
+}
+
+void GOAPDecisionMaker::AddAction(const GOAPAction& action)
+{
+	m_Actions.push_back(action);
+}
+
+void GOAPDecisionMaker::AddGoal(const GOAPGoal& goal)
+{
+	m_Goals.push_back(goal);
+}
+
+void GOAPDecisionMaker::Update(float deltaT)
+{
+	m_pBlackBoard->ChangeData("DeltaTime", deltaT);
+
+	const GOAPWorldState worldState = SenseWorldState();
+
+	//Reactive behavior goes first, the plan waits
+	if (m_pReactiveBehavior && m_pReactiveBehavior->Execute(m_pBlackBoard) != BehaviorState::Failure) return;
+
+	//Drop the plan when the goal changes
+	const unsigned int goal = SelectGoal(worldState);
+	if (goal != m_CurrentGoal)
+	{
+		ClearPlan();
+		m_CurrentGoal = goal;
+	}
+
+	//Only replan when the next action can no longer be executed
+	if (!m_Plan.empty())
+	{
+		const GOAPAction& action = m_Actions[m_Plan[m_PlanStep]];
+		if ((worldState & action.preconditionMask) != action.preconditionValues) ClearPlan();
+	}
+
+	//Follow the plan, or fall back while there is none
+	if (goal != InvalidIndex && (!m_Plan.empty() || StartPlan(goal, worldState)))
+	{
+		ExecutePlan();
+		return;
+	}
+
+	if (m_pFallbackBehavior) m_pFallbackBehavior->Execute(m_pBlackBoard);
+}
+
+GOAPWorldState GOAPDecisionMaker::SenseWorldState() const
+{
+	GOAPWorldState worldState = 0;
+	for (size_t i = 0; i < m_Sensors.size(); ++i)
+	{
+		if (m_Sensors[i](m_pBlackBoard)) worldState |= GOAPWorldState(1) << i;
+	}
+	return worldState;
+}
+
+unsigned int GOAPDecisionMaker::SelectGoal(GOAPWorldState worldState) const
+{
+	unsigned int bestGoal = InvalidIndex;
+	float bestPriority = 0.0f;
+
+	for (unsigned int i = 0; i < m_Goals.size(); ++i)
+	{
+		const GOAPGoal& goal = m_Goals[i];
+
+		//Skip fulfilled goals
+		if ((worldState & goal.mask) == goal.values) continue;
+
+		const float priority = goal.fpPriority(m_pBlackBoard);
+		if (priority <= bestPriority) continue;
+
+		//Skip goals that are known to be unreachable from this state
+		const auto it = m_PlanCache.find(GetCacheKey(i, worldState));
+		if (it != m_PlanCache.end() && it->second.empty()) continue;
+
+		bestGoal = i;
+		bestPriority = priority;
+	}
+
+	return bestGoal;
+}
+
+bool GOAPDecisionMaker::StartPlan(unsigned int goal, GOAPWorldState worldState)
+{
+	//Reuse a cached plan
+	const uint64_t cacheKey = GetCacheKey(goal, worldState);
+	const auto it = m_PlanCache.find(cacheKey);
+	if (it != m_PlanCache.end())
+	{
+		if (it->second.empty()) return false;
+
+		m_Plan = it->second;
+		m_PlanStep = 0;
+		m_PlanKey = cacheKey;
+		return true;
+	}
+
+	//Start a new search when nothing is being planned for this goal
+	if (!m_Planner.IsSearching() || m_PlanningGoal != goal)
+	{
+		m_PlanningGoal = goal;
+		m_PlanningState = worldState;
+		m_Planner.Begin(m_Actions, worldState, m_Goals[goal].mask, m_Goals[goal].values);
+	}
+
+	//Spend a limited amount of work each frame
+	if (!m_Planner.Step(m_Actions, m_MaxExpansionsPerFrame)) return false;
+
+	//Cache the result, also when no plan was found
+	if (m_PlanCache.size() >= MaxCachedPlans) m_PlanCache.clear();
+	const std::vector<unsigned int>& plan = m_Planner.GetPlan();
+	m_PlanCache[GetCacheKey(m_PlanningGoal, m_PlanningState)] = m_Planner.HasPlan() ? plan : std::vector<unsigned int>{};
+
+	//The world might have changed during the search, the next frame picks up the right plan
+	if (!m_Planner.HasPlan() || m_PlanningState != worldState) return false;
+
+	m_Plan = plan;
+	m_PlanStep = 0;
+	m_PlanKey = cacheKey;
+	return true;
+}
+
+void GOAPDecisionMaker::ExecutePlan()
+{
+	const GOAPAction& action = m_Actions[m_Plan[m_PlanStep]];
+
+	switch (action.pBehavior->Execute(m_pBlackBoard))
+	{
+	case BehaviorState::Success:
+		//Move on to the next action, the goal is checked again next frame
+		++m_PlanStep;
+		if (m_PlanStep >= m_Plan.size()) ClearPlan();
+		break;
+	case BehaviorState::Failure:
+		//The plan does not work in this world, forget it
+		m_PlanCache.erase(m_PlanKey);
+		ClearPlan();
+		break;
+	case BehaviorState::Running:
+		break;
+	}
+}
+
+void GOAPDecisionMaker::ClearPlan()
+{
+	m_Plan.clear();
+	m_PlanStep = 0;
+}
+
+uint64_t GOAPDecisionMaker::GetCacheKey(unsigned int goal, GOAPWorldState worldState) const
+{
+	return (static_cast<uint64_t>(goal) << 32) | worldState;
+}
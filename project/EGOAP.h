@@ -0,0 +1,160 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGOAP.h: Goal oriented action planning, A* over a bitset world state
+/*=============================================================================*/
+#ifndef ELITE_GOAP
+#define ELITE_GOAP
+
+//--- Includes ---
+#include <unordered_map>
+#include <stdint.h>
+#include "EBlackboard.h"
+#include "EBehaviorTree.h"
+
+namespace Elite
+{
+	//-----------------------------------------------------------------
+	// GOAP HELPERS
+	//-----------------------------------------------------------------
+	//Every fact of the world is one bit
+	typedef uint32_t GOAPWorldState;
+
+	struct GOAPAction
+	{
+		std::string name;
+		GOAPWorldState preconditionMask;
+		GOAPWorldState preconditionValues;
+		GOAPWorldState effectMask;
+		GOAPWorldState effectValues;
+		float cost;
+		IBehavior* pBehavior; //Success: action done, Running: keep executing, Failure: replan
+	};
+
+	struct GOAPGoal
+	{
+		std::string name;
+		GOAPWorldState mask;
+		GOAPWorldState values;
+		std::function<float(Blackboard*)> fpPriority; //A priority of 0 or less disables the goal
+	};
+
+	//-----------------------------------------------------------------
+	// GOAP PLANNER
+	//-----------------------------------------------------------------
+	//Forward A* search from the current world state to a state that fulfills the goal.
+	//The search can be spread over multiple frames by limiting the number of expanded states per step.
+	class GOAPPlanner final
+	{
+	public:
+		GOAPPlanner() = default;
+
+		void Begin(const std::vector<GOAPAction>& actions, GOAPWorldState start, GOAPWorldState goalMask, GOAPWorldState goalValues);
+		//Returns true when the search is finished, HasPlan() tells if a plan was found
+		bool Step(const std::vector<GOAPAction>& actions, unsigned int maxExpansions);
+
+		bool IsSearching() const { return m_IsSearching; }
+		bool HasPlan() const { return m_HasPlan; }
+		const std::vector<unsigned int>& GetPlan() const { return m_Plan; }
+
+	private:
+		struct OpenNode
+		{
+			float fCost;
+			GOAPWorldState state;
+
+			bool operator>(const OpenNode& other) const { return fCost > other.fCost; }
+		};
+
+		struct NodeRecord
+		{
+			GOAPWorldState parent;
+			unsigned int action;
+			float gCost;
+			bool isClosed;
+		};
+
+		float GetHeuristic(GOAPWorldState state) const;
+		void BuildPlan(GOAPWorldState state);
+
+		std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> m_OpenList = {};
+		std::unordered_map<GOAPWorldState, NodeRecord> m_Records = {};
+		std::vector<unsigned int> m_Plan = {};
+
+		GOAPWorldState m_Start = 0;
+		GOAPWorldState m_GoalMask = 0;
+		GOAPWorldState m_GoalValues = 0;
+		float m_MinActionCost = 1.0f;
+		bool m_IsSearching = false;
+		bool m_HasPlan = false;
+
+		//A search never visits more states than this
+		static constexpr size_t MaxRecords = 4096;
+	};
+
+	//-----------------------------------------------------------------
+	// GOAP DECISION MAKER
+	//-----------------------------------------------------------------
+	//Each frame: sense the world state, pick the most important unfulfilled goal and execute the next action of its plan.
+	//Plans are cached per (goal, start state) and only replaced when the next action can no longer be executed.
+	class GOAPDecisionMaker final : public IDecisionMaking
+	{
+	public:
+		explicit GOAPDecisionMaker(Blackboard* pBlackBoard, BehaviorArena* pArena, unsigned int maxExpansionsPerFrame = 32);
+		~GOAPDecisionMaker();
+
+		GOAPDecisionMaker(const GOAPDecisionMaker& other) = delete;
+		GOAPDecisionMaker& operator=(const GOAPDecisionMaker& other) = delete;
+		GOAPDecisionMaker(GOAPDecisionMaker&& other) = delete;
+		GOAPDecisionMaker& operator=(GOAPDecisionMaker&& other) = delete;
+
+		//Returns the bit of the fact in the world state
+		GOAPWorldState AddFact(const std::function<bool(Blackboard*)>& fpSensor);
+		void AddAction(const GOAPAction& action);
+		void AddGoal(const GOAPGoal& goal);
+
+		//Executed every frame before the plan, the plan pauses while it succeeds or runs
+		void SetReactiveBehavior(IBehavior* pBehavior) { m_pReactiveBehavior = pBehavior; }
+		//Executed when there is no plan to follow
+		void SetFallbackBehavior(IBehavior* pBehavior) { m_pFallbackBehavior = pBehavior; }
+
+		virtual void Update(float deltaT) override;
+
+		Blackboard* GetBlackboard() const { return m_pBlackBoard; }
+
+	private:
+		GOAPWorldState SenseWorldState() const;
+		unsigned int SelectGoal(GOAPWorldState worldState) const;
+		bool StartPlan(unsigned int goal, GOAPWorldState worldState);
+		void ExecutePlan();
+		void ClearPlan();
+		uint64_t GetCacheKey(unsigned int goal, GOAPWorldState worldState) const;
+
+		Blackboard* m_pBlackBoard = nullptr;
+		BehaviorArena* m_pArena = nullptr;
+		IBehavior* m_pReactiveBehavior = nullptr;
+		IBehavior* m_pFallbackBehavior = nullptr;
+
+		std::vector<std::function<bool(Blackboard*)>> m_Sensors = {};
+		std::vector<GOAPAction> m_Actions = {};
+		std::vector<GOAPGoal> m_Goals = {};
+
+		GOAPPlanner m_Planner = {};
+		unsigned int m_MaxExpansionsPerFrame = 32;
+
+		//Cached plans, an empty plan means the goal can not be reached from that state
+		std::unordered_map<uint64_t, std::vector<unsigned int>> m_PlanCache = {};
+		static constexpr size_t MaxCachedPlans = 128;
+
+		unsigned int m_CurrentGoal = InvalidIndex;
+		unsigned int m_PlanningGoal = InvalidIndex;
+		GOAPWorldState m_PlanningState = 0;
+		std::vector<unsigned int> m_Plan = {};
+		size_t m_PlanStep = 0;
+		//The cache entry the current plan came from, the world state has moved on once a step succeeded
+		uint64_t m_PlanKey = 0;
+
+		static constexpr unsigned int InvalidIndex = static_cast<unsigned int>(-1);
+	};
+}
+#endif
@@ -0,0 +1,197 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EStaticBehaviorTree.h: A behavior tree that is built from types at compile time
+/*=============================================================================*/
+#ifndef ELITE_STATIC_BEHAVIOR_TREE
+#define ELITE_STATIC_BEHAVIOR_TREE
+
+//--- Includes ---
+#include <tuple>
+#include <utility>
+#include "EBehaviorTree.h"
+#include "EBehaviorRoutine.h"
+
+namespace Elite
+{
+	//-----------------------------------------------------------------
+	// STATIC BEHAVIOR TREE
+	//-----------------------------------------------------------------
+	//A fixed tree is written as one type, for example:
+	//	Static::Selector<Static::Sequence<Static::Cond<IsEnemyInFront>, Static::Act<Shoot>>, Static::Act<Explore>>
+	//Every node calls its children directly, so the compiler can inline the whole tree.
+	//The nodes give the same results as their runtime counterparts in EBehaviorTree.h.
+	namespace Static
+	{
+		//--- CONDITIONAL ---
+		template<bool(*fpConditional)(Blackboard*)>
+		class Cond final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				return fpConditional(pBlackBoard) ? BehaviorState::Success : BehaviorState::Failure;
+			}
+		};
+
+		//--- ACTION ---
+		template<BehaviorState(*fpAction)(Blackboard*)>
+		class Act final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				return fpAction(pBlackBoard);
+			}
+		};
+
+		//--- ROUTINE ---
+		//The node keeps the frame of its routine, so it is reused every time the routine starts again
+		template<BehaviorRoutineFunction fpRoutine>
+		class Routine final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				if (!m_Routine) m_Routine = fpRoutine(m_Pool, pBlackBoard);
+
+				const BehaviorState state{ m_Routine.Resume() };
+				if (m_Routine.IsDone()) m_Routine = BehaviorRoutine{};
+				return state;
+			}
+
+		private:
+			BehaviorRoutinePool m_Pool{};
+			BehaviorRoutine m_Routine{};
+		};
+
+		//--- SELECTOR ---
+		//Stops at the first child that does not fail
+		template<typename... Children>
+		class Selector final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				return Execute(pBlackBoard, std::index_sequence_for<Children...>{});
+			}
+
+		private:
+			std::tuple<Children...> m_ChildBehaviors{};
+
+			template<size_t... indices>
+			BehaviorState Execute(Blackboard* pBlackBoard, std::index_sequence<indices...>)
+			{
+				BehaviorState state{ BehaviorState::Failure };
+				(void)((((state = std::get<indices>(m_ChildBehaviors).Execute(pBlackBoard)) == BehaviorState::Failure) && ...));
+				return state;
+			}
+		};
+
+		//--- SEQUENCE ---
+		//Stops at the first child that does not succeed
+		template<typename... Children>
+		class Sequence final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				return Execute(pBlackBoard, std::index_sequence_for<Children...>{});
+			}
+
+		private:
+			std::tuple<Children...> m_ChildBehaviors{};
+
+			template<size_t... indices>
+			BehaviorState Execute(Blackboard* pBlackBoard, std::index_sequence<indices...>)
+			{
+				BehaviorState state{ BehaviorState::Success };
+				(void)((((state = std::get<indices>(m_ChildBehaviors).Execute(pBlackBoard)) == BehaviorState::Success) && ...));
+				return state;
+			}
+		};
+
+		//--- PARTIAL SEQUENCE ---
+		//Executes one child per call and remembers where it stopped
+		template<typename... Children>
+		class PartialSequence final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				if (m_CurrentBehaviorIndex >= sizeof...(Children))
+				{
+					m_CurrentBehaviorIndex = 0;
+					return BehaviorState::Success;
+				}
+
+				switch (ExecuteCurrent(pBlackBoard, std::index_sequence_for<Children...>{}))
+				{
+				case BehaviorState::Failure:
+					m_CurrentBehaviorIndex = 0;
+					return BehaviorState::Failure;
+				case BehaviorState::Success:
+					++m_CurrentBehaviorIndex;
+					return BehaviorState::Running;
+				case BehaviorState::Running:
+					break;
+				}
+				return BehaviorState::Running;
+			}
+
+		private:
+			std::tuple<Children...> m_ChildBehaviors{};
+			unsigned int m_CurrentBehaviorIndex{};
+
+			template<size_t... indices>
+			BehaviorState ExecuteCurrent(Blackboard* pBlackBoard, std::index_sequence<indices...>)
+			{
+				BehaviorState state{ BehaviorState::Failure };
+				(void)((indices == m_CurrentBehaviorIndex && ((state = std::get<indices>(m_ChildBehaviors).Execute(pBlackBoard)), true)) || ...);
+				return state;
+			}
+		};
+
+		//--- INVERTOR ---
+		template<typename Child>
+		class Invertor final
+		{
+		public:
+			BehaviorState Execute(Blackboard* pBlackBoard)
+			{
+				switch (m_ChildBehavior.Execute(pBlackBoard))
+				{
+				case BehaviorState::Failure:
+					return BehaviorState::Success;
+				case BehaviorState::Success:
+					return BehaviorState::Failure;
+				case BehaviorState::Running:
+					break;
+				}
+				return BehaviorState::Running;
+			}
+
+		private:
+			Child m_ChildBehavior{};
+		};
+	}
+
+	//-----------------------------------------------------------------
+	// STATIC BEHAVIOR (IBehavior)
+	//-----------------------------------------------------------------
+	//Wraps a static tree so it can be used anywhere a runtime behavior is expected, only this call is virtual
+	template<typename Root>
+	class StaticBehavior final : public IBehavior
+	{
+	public:
+		virtual BehaviorState Execute(Blackboard* pBlackBoard) override
+		{
+			m_CurrentState = m_Root.Execute(pBlackBoard);
+			return m_CurrentState;
+		}
+
+	private:
+		Root m_Root{};
+	};
+}
+#endif
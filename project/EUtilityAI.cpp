@@ -0,0 +1,140 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EUtilityAI.h"
+using namespace Elite;
+
+UtilityDecisionMaker::UtilityDecisionMaker(Blackboard* pBlackBoard, BehaviorArena* pArena, float hysteresis)
+	: m_pBlackBoard(pBlackBoard), m_pArena(pArena), m_Hysteresis(hysteresis)
+{
+}
+
+UtilityDecisionMaker::~UtilityDecisionMaker()
+{
+	if (m_pArena) delete m_pArena; //Takes ownership of passed arena, this releases every option behavior
+	if (m_pBlackBoard) delete m_pBlackBoard; //Takes ownership of passed blackboard!
+}
+
+unsigned int UtilityDecisionMaker::AddConsideration(const std::function<float(Blackboard*)>& fpConsideration)
+{
+	m_Considerations.push_back(fpConsideration);
+	m_Inputs.push_back(0.0f);
+
+	//Every existing option ignores the new consideration: slope 0, intercept 1
+	Response response{};
+	response.slopes.resize(m_OptionNames.size(), 0.0f);
+	response.intercepts.resize(m_OptionNames.size(), 1.0f);
+	m_Responses.push_back(response);
+
+	return static_cast<unsigned int>(m_Considerations.size() - 1);
+}
+
+unsigned int UtilityDecisionMaker::AddOption(const std::string& name, IBehavior* pBehavior, float weight)
+{
+	m_OptionNames.push_back(name);
+	m_OptionBehaviors.push_back(pBehavior);
+	m_Weights.push_back(weight);
+	m_Scores.push_back(0.0f);
+	m_IsTried.push_back(false);
+
+	//The new option ignores every existing consideration
+	for (Response& response : m_Responses)
+	{
+		response.slopes.push_back(0.0f);
+		response.intercepts.push_back(1.0f);
+	}
+
+	return static_cast<unsigned int>(m_OptionNames.size() - 1);
+}
+
+void UtilityDecisionMaker::SetResponse(unsigned int option, unsigned int consideration, float slope, float intercept)
+{
+	m_Responses[consideration].slopes[option] = slope;
+	m_Responses[consideration].intercepts[option] = intercept;
+}
+
+void UtilityDecisionMaker::Update(float deltaT)
+{
+	m_pBlackBoard->ChangeData("DeltaTime", deltaT);
+
+	EvaluateConsiderations();
+	ScoreOptions();
+
+	//Execute the best option, when it fails fall through to the next best option
+	std::fill(m_IsTried.begin(), m_IsTried.end(), false);
+	for (size_t i = 0; i < m_OptionNames.size(); ++i)
+	{
+		const unsigned int option = GetBestUntriedOption();
+		if (option == InvalidOption) break;
+
+		m_IsTried[option] = true;
+		if (m_OptionBehaviors[option]->Execute(m_pBlackBoard) != BehaviorState::Failure)
+		{
+			m_CurrentOption = option;
+			return;
+		}
+	}
+
+	m_CurrentOption = InvalidOption;
+}
+
+const std::string& UtilityDecisionMaker::GetCurrentOptionName() const
+{
+	static const std::string noOption = "None";
+	return m_CurrentOption == InvalidOption ? noOption : m_OptionNames[m_CurrentOption];
+}
+
+void UtilityDecisionMaker::EvaluateConsiderations()
+{
+	//Every consideration is evaluated exactly once per frame
+	for (size_t i = 0; i < m_Considerations.size(); ++i)
+	{
+		m_Inputs[i] = m_Considerations[i](m_pBlackBoard);
+	}
+}
+
+void UtilityDecisionMaker::ScoreOptions()
+{
+	const size_t nrOptions = m_Scores.size();
+	float* pScores = m_Scores.data();
+
+	//Start from the weight of every option
+	std::copy(m_Weights.begin(), m_Weights.end(), m_Scores.begin());
+
+	//Multiply in the response of every option to one input at a time
+	for (size_t consideration = 0; consideration < m_Inputs.size(); ++consideration)
+	{
+		const float input = m_Inputs[consideration];
+		const float* pSlopes = m_Responses[consideration].slopes.data();
+		const float* pIntercepts = m_Responses[consideration].intercepts.data();
+
+		for (size_t option = 0; option < nrOptions; ++option)
+		{
+			const float response = pSlopes[option] * input + pIntercepts[option];
+			pScores[option] *= response < 0.0f ? 0.0f : (response > 1.0f ? 1.0f : response);
+		}
+	}
+
+	//Keep the current option unless another option is clearly better
+	//The bonus scales with the score, so a low option can not climb over a higher weighted one
+	if (m_CurrentOption != InvalidOption)
+	{
+		pScores[m_CurrentOption] *= 1.0f + m_Hysteresis;
+	}
+}
+
+unsigned int UtilityDecisionMaker::GetBestUntriedOption() const
+{
+	unsigned int bestOption = InvalidOption;
+	float bestScore = 0.0f;
+
+	for (unsigned int option = 0; option < m_Scores.size(); ++option)
+	{
+		//Options without any score are never executed
+		if (m_IsTried[option] || m_Scores[option] <= bestScore) continue;
+
+		bestOption = option;
+		bestScore = m_Scores[option];
+	}
+
+	return bestOption;
+}
@@ -0,0 +1,76 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EUtilityAI.h: Utility based decision making, the best scoring option gets executed
+/*=============================================================================*/
+#ifndef ELITE_UTILITY_AI
+#define ELITE_UTILITY_AI
+
+//--- Includes ---
+#include "EBlackboard.h"
+#include "EBehaviorTree.h"
+
+namespace Elite
+{
+	//-----------------------------------------------------------------
+	// UTILITY DECISION MAKER
+	//-----------------------------------------------------------------
+	//Considerations are evaluated once per frame into a list of inputs (0 - 1).
+	//Every option maps every input through a linear response curve: clamp(slope * input + intercept, 0, 1).
+	//The score of an option is its weight multiplied by all of its responses.
+	//Responses are stored per consideration for all options next to each other, so scoring is one tight loop per input.
+	class UtilityDecisionMaker final : public IDecisionMaking
+	{
+	public:
+		explicit UtilityDecisionMaker(Blackboard* pBlackBoard, BehaviorArena* pArena, float hysteresis = 0.05f);
+		~UtilityDecisionMaker();
+
+		UtilityDecisionMaker(const UtilityDecisionMaker& other) = delete;
+		UtilityDecisionMaker& operator=(const UtilityDecisionMaker& other) = delete;
+		UtilityDecisionMaker(UtilityDecisionMaker&& other) = delete;
+		UtilityDecisionMaker& operator=(UtilityDecisionMaker&& other) = delete;
+
+		unsigned int AddConsideration(const std::function<float(Blackboard*)>& fpConsideration);
+		unsigned int AddOption(const std::string& name, IBehavior* pBehavior, float weight = 1.0f);
+		void SetResponse(unsigned int option, unsigned int consideration, float slope, float intercept);
+
+		virtual void Update(float deltaT) override;
+
+		Blackboard* GetBlackboard() const { return m_pBlackBoard; }
+		const std::string& GetCurrentOptionName() const;
+
+	private:
+		struct Response
+		{
+			std::vector<float> slopes;
+			std::vector<float> intercepts;
+		};
+
+		void EvaluateConsiderations();
+		void ScoreOptions();
+		unsigned int GetBestUntriedOption() const;
+
+		Blackboard* m_pBlackBoard = nullptr;
+		BehaviorArena* m_pArena = nullptr;
+
+		//Per consideration
+		std::vector<std::function<float(Blackboard*)>> m_Considerations = {};
+		std::vector<float> m_Inputs = {};
+		std::vector<Response> m_Responses = {};
+
+		//Per option
+		std::vector<std::string> m_OptionNames = {};
+		std::vector<IBehavior*> m_OptionBehaviors = {};
+		std::vector<float> m_Weights = {};
+		std::vector<float> m_Scores = {};
+		std::vector<bool> m_IsTried = {};
+
+		//Relative bonus for the current option so the agent does not flip between two equal options
+		//Kept below the gap between the weights of neighbouring options, so it never overturns their order
+		float m_Hysteresis = 0.05f;
+		unsigned int m_CurrentOption = InvalidOption;
+
+		static constexpr unsigned int InvalidOption = static_cast<unsigned int>(-1);
+	};
+}
+#endif
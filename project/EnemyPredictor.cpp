@@ -0,0 +1,100 @@
+#include "stdafx.h"
+#include "EnemyPredictor.h"
+#include "EnemyTracker.h"
+
+EnemyPredictor::EnemyPredictor(const EnemyTracker* pTracker)
+	: m_pTracker{ pTracker }
+{
+}
+
+bool EnemyPredictor::SelectTarget(const AgentInfo& agentInfo, Elite::Vector2& aimPoint) const
+{
+	float bestHitChance{ -1.0f };
+
+	// Every shot costs the same ammo, so the best target is the one that is the most likely to be hit
+	// On a tie the closest enemy wins
+	for (UINT enemyIndex : m_pTracker->GetVisible())
+	{
+		const float hitChance{ GetHitChance(agentInfo, enemyIndex) };
+		if (hitChance <= bestHitChance) continue;
+
+		float interceptTime{};
+		bestHitChance = hitChance;
+		aimPoint = GetInterceptPoint(agentInfo, enemyIndex, interceptTime);
+	}
+
+	return bestHitChance >= 0.0f;
+}
+
+bool EnemyPredictor::IsInLineOfFire(const AgentInfo& agentInfo, float range) const
+{
+	const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
+
+	for (UINT enemyIndex : m_pTracker->GetVisible())
+	{
+		const Elite::Vector2 toEnemy{ m_pTracker->GetLastPosition(enemyIndex) - agentInfo.Position };
+
+		// The bullet has to pass through the body of the enemy
+		if (lookDir.Dot(toEnemy) <= 0.0f || toEnemy.MagnitudeSquared() > range * range) continue;
+		if (abs(lookDir.Cross(toEnemy)) < m_pTracker->GetSize(enemyIndex)) return true;
+	}
+
+	return false;
+}
+
+int EnemyPredictor::GetNrInCone(const AgentInfo& agentInfo, float range, float halfAngle) const
+{
+	const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
+	const float cosHalfAngle{ cosf(halfAngle) };
+
+	int nrInCone{};
+	for (UINT enemyIndex : m_pTracker->GetVisible())
+	{
+		const Elite::Vector2 toEnemy{ m_pTracker->GetLastPosition(enemyIndex) - agentInfo.Position };
+		const float distance{ toEnemy.Magnitude() };
+		if (distance > range) continue;
+
+		// Enemies on the edge of the cone still count with their body
+		if (abs(lookDir.Cross(toEnemy)) < m_pTracker->GetSize(enemyIndex) || lookDir.Dot(toEnemy) >= distance * cosHalfAngle) ++nrInCone;
+	}
+
+	return nrInCone;
+}
+
+float EnemyPredictor::GetHitChance(const AgentInfo& agentInfo, UINT enemyIndex) const
+{
+	const float size{ m_pTracker->GetSize(enemyIndex) };
+
+	float interceptTime{};
+	const Elite::Vector2 aimPoint{ GetInterceptPoint(agentInfo, enemyIndex, interceptTime) };
+	const float distance{ std::max(aimPoint.Distance(agentInfo.Position), size) };
+
+	// The enemy covers this angle, the aim can be off by the velocity error over the time to turn
+	const float targetAngle{ asinf(std::min(1.0f, size / distance)) };
+	const float aimError{ atanf(m_pTracker->GetVelocityError(enemyIndex) * interceptTime / distance) };
+
+	return targetAngle / (targetAngle + aimError);
+}
+
+Elite::Vector2 EnemyPredictor::GetInterceptPoint(const AgentInfo& agentInfo, UINT enemyIndex, float& interceptTime) const
+{
+	const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
+	const Elite::Vector2& position{ m_pTracker->GetLastPosition(enemyIndex) };
+	const Elite::Vector2& velocity{ m_pTracker->GetVelocity(enemyIndex) };
+
+	// The time to turn depends on where the enemy will be, a few iterations converge
+	Elite::Vector2 aimPoint{ position };
+	interceptTime = 0.0f;
+	for (int i{}; i < m_NrInterceptIterations; ++i)
+	{
+		Elite::Vector2 toAimPoint{ aimPoint - agentInfo.Position };
+		if (toAimPoint.Normalize() < FLT_EPSILON) break;
+
+		const float angle{ acosf(Elite::Clamp(lookDir.Dot(toAimPoint), -1.0f, 1.0f)) };
+		interceptTime = agentInfo.MaxAngularSpeed > FLT_EPSILON ? angle / agentInfo.MaxAngularSpeed : 0.0f;
+
+		aimPoint = position + velocity * interceptTime;
+	}
+
+	return aimPoint;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+
+class EnemyTracker;
+
+// Uses the tracked enemies to aim where an enemy will be instead of where it is
+class EnemyPredictor final
+{
+public:
+	EnemyPredictor(const EnemyTracker* pTracker);
+
+	// Picks the visible enemy that is the most likely to be hit, returns false when no enemy is visible
+	bool SelectTarget(const AgentInfo& agentInfo, Elite::Vector2& aimPoint) const;
+
+	// Is a visible enemy on the line of fire when shooting now?
+	bool IsInLineOfFire(const AgentInfo& agentInfo, float range) const;
+	// How many visible enemies a cone shot would hit
+	int GetNrInCone(const AgentInfo& agentInfo, float range, float halfAngle) const;
+
+	// The chance the enemy gets hit after the agent turned towards its aim point
+	float GetHitChance(const AgentInfo& agentInfo, UINT enemyIndex) const;
+private:
+	Elite::Vector2 GetInterceptPoint(const AgentInfo& agentInfo, UINT enemyIndex, float& interceptTime) const;
+
+	const EnemyTracker* m_pTracker{};
+
+	// Bullets hit instantly, only the time to turn towards the enemy has to be predicted
+	constexpr static int m_NrInterceptIterations{ 3 };
+};
@@ -0,0 +1,203 @@
+#include "stdafx.h"
+#include "EnemyTracker.h"
+#include "IExamInterface.h"
+#include "Perception.h"
+
+void EnemyTracker::Update(IExamInterface* pInterface, const Perception& perception, const AgentInfo& agentInfo, float deltaTime)
+{
+	m_Time += deltaTime;
+
+	m_VisibleHashes.clear();
+
+	for (UINT index : perception.GetEnemies())
+	{
+		EnemyInfo enemyInfo{};
+		if (!pInterface->Enemy_GetInfo(perception.GetEntity(index), enemyInfo)) continue;
+
+		m_VisibleHashes.push_back(enemyInfo.EnemyHash);
+
+		const auto it{ m_Indices.find(enemyInfo.EnemyHash) };
+		if (it == m_Indices.end())
+		{
+			// A new enemy starts with the velocity it has right now
+			Add(enemyInfo);
+			continue;
+		}
+
+		const UINT i{ it->second };
+
+		// Smooth the velocity, zombies wander and a single sample overshoots
+		const Elite::Vector2 velocityChange{ enemyInfo.LinearVelocity - m_Velocities[i] };
+		m_Velocities[i] += velocityChange * m_VelocitySmoothing;
+		m_VelocityErrors[i] += (velocityChange.Magnitude() - m_VelocityErrors[i]) * m_VelocitySmoothing;
+
+		m_Sizes[i] = enemyInfo.Size;
+		m_Healths[i] = enemyInfo.Health;
+		m_Positions[i] = enemyInfo.Location;
+		m_LastSeenTimes[i] = m_Time;
+	}
+
+	for (UINT i{}; i < m_Hashes.size();)
+	{
+		if (IsForgotten(i, agentInfo)) Remove(i);
+		else ++i;
+	}
+
+	// Removing enemies moves the others, so only look up the visible ones now
+	m_Visible.clear();
+	for (int enemyHash : m_VisibleHashes)
+	{
+		m_Visible.push_back(m_Indices[enemyHash]);
+	}
+}
+
+size_t EnemyTracker::GetNrEnemies() const
+{
+	return m_Hashes.size();
+}
+
+const std::vector<UINT>& EnemyTracker::GetVisible() const
+{
+	return m_Visible;
+}
+
+int EnemyTracker::Find(int enemyHash) const
+{
+	const auto it{ m_Indices.find(enemyHash) };
+	return it == m_Indices.end() ? -1 : static_cast<int>(it->second);
+}
+
+int EnemyTracker::GetNearestThreat(const Elite::Vector2& position, float maxDistance) const
+{
+	int nearest{ -1 };
+	float closestDistance{ maxDistance < FLT_MAX ? maxDistance * maxDistance : FLT_MAX };
+
+	for (UINT i{}; i < m_Hashes.size(); ++i)
+	{
+		const float distance{ GetPredictedPosition(i).DistanceSquared(position) };
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			nearest = static_cast<int>(i);
+		}
+	}
+
+	return nearest;
+}
+
+int EnemyTracker::GetNrThreatsInRadius(const Elite::Vector2& position, float radius) const
+{
+	int nrThreats{};
+	for (UINT i{}; i < m_Hashes.size(); ++i)
+	{
+		if (GetPredictedPosition(i).DistanceSquared(position) <= radius * radius) ++nrThreats;
+	}
+	return nrThreats;
+}
+
+int EnemyTracker::GetHash(UINT index) const
+{
+	return m_Hashes[index];
+}
+
+eEnemyType EnemyTracker::GetType(UINT index) const
+{
+	return m_Types[index];
+}
+
+float EnemyTracker::GetSize(UINT index) const
+{
+	return m_Sizes[index];
+}
+
+float EnemyTracker::GetHealth(UINT index) const
+{
+	return m_Healths[index];
+}
+
+const Elite::Vector2& EnemyTracker::GetLastPosition(UINT index) const
+{
+	return m_Positions[index];
+}
+
+Elite::Vector2 EnemyTracker::GetPredictedPosition(UINT index) const
+{
+	return m_Positions[index] + m_Velocities[index] * std::min(GetTimeUnseen(index), m_MaxPredictionTime);
+}
+
+const Elite::Vector2& EnemyTracker::GetVelocity(UINT index) const
+{
+	return m_Velocities[index];
+}
+
+float EnemyTracker::GetVelocityError(UINT index) const
+{
+	return m_VelocityErrors[index];
+}
+
+float EnemyTracker::GetTimeUnseen(UINT index) const
+{
+	return m_Time - m_LastSeenTimes[index];
+}
+
+bool EnemyTracker::IsVisible(UINT index) const
+{
+	return m_LastSeenTimes[index] >= m_Time;
+}
+
+void EnemyTracker::Add(const EnemyInfo& enemyInfo)
+{
+	m_Indices[enemyInfo.EnemyHash] = static_cast<UINT>(m_Hashes.size());
+
+	m_Hashes.push_back(enemyInfo.EnemyHash);
+	m_Types.push_back(enemyInfo.Type);
+	m_Sizes.push_back(enemyInfo.Size);
+	m_Healths.push_back(enemyInfo.Health);
+	m_Positions.push_back(enemyInfo.Location);
+	m_Velocities.push_back(enemyInfo.LinearVelocity);
+	m_VelocityErrors.push_back(0.0f);
+	m_LastSeenTimes.push_back(m_Time);
+}
+
+bool EnemyTracker::IsForgotten(UINT index, const AgentInfo& agentInfo) const
+{
+	if (IsVisible(index)) return false;
+	if (GetTimeUnseen(index) > m_ForgetTime) return true;
+
+	// If the agent looks at the last position and does not see the enemy, it died or moved away
+	const Elite::Vector2 toEnemy{ m_Positions[index] - agentInfo.Position };
+	const float distance{ toEnemy.Magnitude() };
+	if (distance > agentInfo.FOV_Range || distance < FLT_EPSILON) return false;
+
+	const Elite::Vector2 lookDir{ cosf(agentInfo.Orientation), sinf(agentInfo.Orientation) };
+	return lookDir.Dot(toEnemy) >= distance * cosf(agentInfo.FOV_Angle / 2.0f);
+}
+
+void EnemyTracker::Remove(UINT index)
+{
+	// Move the last enemy in the gap, so the arrays stay packed
+	const UINT last{ static_cast<UINT>(m_Hashes.size() - 1) };
+
+	m_Indices.erase(m_Hashes[index]);
+	if (index != last)
+	{
+		m_Hashes[index] = m_Hashes[last];
+		m_Types[index] = m_Types[last];
+		m_Sizes[index] = m_Sizes[last];
+		m_Healths[index] = m_Healths[last];
+		m_Positions[index] = m_Positions[last];
+		m_Velocities[index] = m_Velocities[last];
+		m_VelocityErrors[index] = m_VelocityErrors[last];
+		m_LastSeenTimes[index] = m_LastSeenTimes[last];
+		m_Indices[m_Hashes[index]] = index;
+	}
+
+	m_Hashes.pop_back();
+	m_Types.pop_back();
+	m_Sizes.pop_back();
+	m_Healths.pop_back();
+	m_Positions.pop_back();
+	m_Velocities.pop_back();
+	m_VelocityErrors.pop_back();
+	m_LastSeenTimes.pop_back();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <unordered_map>
+
+class IExamInterface;
+class Perception;
+
+// Remembers every enemy the agent has seen, keyed by its EnemyHash
+// Every field is stored in its own array, queries over all enemies only touch the fields they need
+// Enemies that are out of sight for too long, or that are not where the agent looks, are forgotten
+class EnemyTracker final
+{
+public:
+	void Update(IExamInterface* pInterface, const Perception& perception, const AgentInfo& agentInfo, float deltaTime);
+
+	size_t GetNrEnemies() const;
+	// The enemies in fov, closest first
+	const std::vector<UINT>& GetVisible() const;
+	// Returns the index of the enemy, or -1 when it is unknown
+	int Find(int enemyHash) const;
+
+	// Returns the index of the closest enemy, seen now or remembered, or -1 when no enemy is this close
+	int GetNearestThreat(const Elite::Vector2& position, float maxDistance = FLT_MAX) const;
+	int GetNrThreatsInRadius(const Elite::Vector2& position, float radius) const;
+
+	int GetHash(UINT index) const;
+	eEnemyType GetType(UINT index) const;
+	float GetSize(UINT index) const;
+	float GetHealth(UINT index) const;
+	const Elite::Vector2& GetLastPosition(UINT index) const;
+	// The last position moved along the velocity since the enemy was last seen
+	Elite::Vector2 GetPredictedPosition(UINT index) const;
+	const Elite::Vector2& GetVelocity(UINT index) const;
+	// How much the velocity changes between frames, a wandering enemy is harder to predict
+	float GetVelocityError(UINT index) const;
+	float GetTimeUnseen(UINT index) const;
+	bool IsVisible(UINT index) const;
+private:
+	void Add(const EnemyInfo& enemyInfo);
+	void Remove(UINT index);
+	bool IsForgotten(UINT index, const AgentInfo& agentInfo) const;
+
+	std::vector<int> m_Hashes{};
+	std::vector<eEnemyType> m_Types{};
+	std::vector<float> m_Sizes{};
+	std::vector<float> m_Healths{};
+	std::vector<Elite::Vector2> m_Positions{};
+	std::vector<Elite::Vector2> m_Velocities{};
+	std::vector<float> m_VelocityErrors{};
+	std::vector<float> m_LastSeenTimes{};
+
+	std::unordered_map<int, UINT> m_Indices{};
+	std::vector<UINT> m_Visible{};
+	std::vector<int> m_VisibleHashes{};
+	float m_Time{};
+
+	// How fast the velocity estimate follows the observed velocity
+	constexpr static float m_VelocitySmoothing{ 0.3f };
+	// Enemies that are out of sight for this long are forgotten
+	constexpr static float m_ForgetTime{ 5.0f };
+	// Zombies wander, their velocity says nothing about where they are after this time
+	constexpr static float m_MaxPredictionTime{ 1.0f };
+};
@@ -4,9 +4,22 @@
 struct CurrentHouse : public HouseInfo
 {
 	int curCornerIndex{};
+
+	// The sweep tour of the house is mirrored so it starts in the corner closest to the agent
+	bool isSweeping{};
+	Elite::Vector2 sweepDirection{ 1.0f, 1.0f };
+
+	// Lets the blackboard see that the same house is stored again
+	bool operator==(const CurrentHouse& other) const
+	{
+		return Center == other.Center && Size == other.Size && curCornerIndex == other.curCornerIndex
+			&& isSweeping == other.isSweeping && sweepDirection == other.sweepDirection;
+	}
 };
 
 struct FoundEntityInfo : public EntityInfo
 {
 	eItemType itemType{};
+	// The ammo, health or energy of the item when it was found, garbage has none
+	int value{};
 };
\ No newline at end of file
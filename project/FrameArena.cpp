@@ -0,0 +1,68 @@
+#include "stdafx.h"
+#include "FrameArena.h"
+
+FrameArena::FrameArena(size_t capacity)
+	: m_pBlock{ static_cast<std::byte*>(operator new(capacity, std::align_val_t{ alignof(std::max_align_t) })) }
+	, m_Capacity{ capacity }
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (void* pOverflow : m_Overflow)
+	{
+		operator delete(pOverflow, std::align_val_t{ alignof(std::max_align_t) });
+	}
+	operator delete(m_pBlock, std::align_val_t{ alignof(std::max_align_t) });
+}
+
+void FrameArena::Reset()
+{
+#ifdef _DEBUG
+	if (m_Peak > m_ReportedPeak)
+	{
+		std::cout << "Frame arena peak: " << m_Peak << " of " << m_Capacity << " bytes\n";
+		m_ReportedPeak = m_Peak;
+	}
+#endif
+
+	// The last frame did not fit, make the block big enough for it
+	if (!m_Overflow.empty())
+	{
+		for (void* pOverflow : m_Overflow)
+		{
+			operator delete(pOverflow, std::align_val_t{ alignof(std::max_align_t) });
+		}
+		m_Overflow.clear();
+
+		operator delete(m_pBlock, std::align_val_t{ alignof(std::max_align_t) });
+		m_Capacity = std::max(m_Peak, m_Capacity * 2);
+		m_pBlock = static_cast<std::byte*>(operator new(m_Capacity, std::align_val_t{ alignof(std::max_align_t) }));
+	}
+
+	m_Offset = 0;
+	m_Used = 0;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	// The block is aligned for every fundamental type, stronger alignments are not supported
+	assert(alignment <= alignof(std::max_align_t));
+
+	// Move the offset to the next multiple of the alignment, which is always a power of two
+	const size_t offset{ (m_Offset + alignment - 1) & ~(alignment - 1) };
+
+	m_Used += size + (offset - m_Offset);
+	m_Peak = std::max(m_Peak, m_Used);
+
+	if (offset + size <= m_Capacity)
+	{
+		m_Offset = offset + size;
+		return m_pBlock + offset;
+	}
+
+	// Does not fit in the block anymore, this frame gets its memory from the heap
+	void* pOverflow{ operator new(size, std::align_val_t{ alignof(std::max_align_t) }) };
+	m_Overflow.push_back(pOverflow);
+	return pOverflow;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// A linear allocator for data that only lives until the end of a frame
+// Allocating moves a pointer forward, freeing does nothing, Reset makes the whole block free again
+// When a frame needs more than the block, the extra memory comes from the heap and the block grows to fit on the next Reset
+class FrameArena final
+{
+public:
+	explicit FrameArena(size_t capacity);
+	~FrameArena();
+
+	FrameArena(const FrameArena& other) = delete;
+	FrameArena& operator=(const FrameArena& other) = delete;
+	FrameArena(FrameArena&& other) = delete;
+	FrameArena& operator=(FrameArena&& other) = delete;
+
+	// Everything that was allocated since the last reset becomes invalid
+	void Reset();
+	void* Allocate(size_t size, size_t alignment);
+
+	size_t GetCapacity() const { return m_Capacity; }
+	size_t GetUsed() const { return m_Used; }
+	size_t GetPeak() const { return m_Peak; }
+private:
+	std::byte* m_pBlock{};
+	size_t m_Capacity{};
+	size_t m_Offset{};
+
+	// The bytes asked for this frame, including the ones that did not fit in the block
+	size_t m_Used{};
+	size_t m_Peak{};
+	// Allocations that did not fit in the block, freed on the next reset
+	std::vector<void*> m_Overflow{};
+
+#ifdef _DEBUG
+	// Only a new peak is reported, so the output stays quiet once the usage settles
+	size_t m_ReportedPeak{};
+#endif
+};
+
+// Lets standard containers allocate from a frame arena, for example:
+//	FrameVector<eItemType> neededItems{ FrameAllocator<eItemType>{ pFrameArena } };
+// The container has to be gone before the arena is reset
+// Not final, the standard containers derive from their allocator
+template<typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	explicit FrameAllocator(FrameArena* pArena) noexcept : m_pArena{ pArena } {}
+	template<typename Other>
+	FrameAllocator(const FrameAllocator<Other>& other) noexcept : m_pArena{ other.GetArena() } {}
+
+	T* allocate(size_t count) { return static_cast<T*>(m_pArena->Allocate(count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	FrameArena* GetArena() const noexcept { return m_pArena; }
+
+	template<typename Other>
+	bool operator==(const FrameAllocator<Other>& other) const noexcept { return m_pArena == other.GetArena(); }
+private:
+	FrameArena* m_pArena{};
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -0,0 +1,58 @@
+#include "stdafx.h"
+#include "HouseGrid.h"
+
+constexpr short HouseGrid::m_Outdoor;
+
+HouseGrid::HouseGrid(const WorldInfo& worldInfo)
+	: m_Origin{ worldInfo.Center - worldInfo.Dimensions / 2.0f }
+	, m_NrColumns{ std::max(1, static_cast<int>(ceilf(worldInfo.Dimensions.x / m_CellSize))) }
+	, m_NrRows{ std::max(1, static_cast<int>(ceilf(worldInfo.Dimensions.y / m_CellSize))) }
+{
+	m_Cells.resize(static_cast<size_t>(m_NrColumns) * m_NrRows, Cell{ m_Outdoor, m_Outdoor });
+}
+
+void HouseGrid::Rasterize(int id, const Elite::Vector2& min, const Elite::Vector2& max)
+{
+	const int minColumn{ GetColumn(min.x) };
+	const int maxColumn{ GetColumn(max.x) };
+	const int minRow{ GetRow(min.y) };
+	const int maxRow{ GetRow(max.y) };
+
+	for (int row{ minRow }; row <= maxRow; ++row)
+	{
+		Cell* pRow{ &m_Cells[static_cast<size_t>(row) * m_NrColumns] };
+		for (int column{ minColumn }; column <= maxColumn; ++column)
+		{
+			// A border cell shared with a neighbour gets both houses, a third house only meets at a corner and is dropped
+			Cell& cell{ pRow[column] };
+			if (cell.first == m_Outdoor) cell.first = static_cast<short>(id);
+			else if (cell.second == m_Outdoor && cell.first != id) cell.second = static_cast<short>(id);
+		}
+	}
+}
+
+const HouseGrid::Cell& HouseGrid::GetCell(const Elite::Vector2& point) const
+{
+	return m_Cells[GetCellIndex(point)];
+}
+
+void HouseGrid::Clear()
+{
+	std::fill(m_Cells.begin(), m_Cells.end(), Cell{ m_Outdoor, m_Outdoor });
+}
+
+int HouseGrid::GetCellIndex(const Elite::Vector2& point) const
+{
+	return GetRow(point.y) * m_NrColumns + GetColumn(point.x);
+}
+
+int HouseGrid::GetColumn(float x) const
+{
+	// Points outside the world belong to the closest border cell
+	return Elite::Clamp(static_cast<int>(floorf((x - m_Origin.x) / m_CellSize)), 0, m_NrColumns - 1);
+}
+
+int HouseGrid::GetRow(float y) const
+{
+	return Elite::Clamp(static_cast<int>(floorf((y - m_Origin.y) / m_CellSize)), 0, m_NrRows - 1);
+}
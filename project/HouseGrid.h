@@ -0,0 +1,39 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+
+// A fine grid over the world that stores which house covers each cell
+// Every cell a house overlaps gets its id, so finding the house at a point is a single lookup
+class HouseGrid final
+{
+public:
+	// The houses that overlap a cell, -1 when there is none
+	// Houses never overlap, only a border cell can be shared with a neighbour
+	struct Cell
+	{
+		short first;
+		short second;
+	};
+
+	HouseGrid(const WorldInfo& worldInfo);
+
+	// Marks every cell that overlaps the bounds, a cell keeps the first two houses that overlap it
+	void Rasterize(int id, const Elite::Vector2& min, const Elite::Vector2& max);
+
+	// Returns the houses that overlap the cell of the point
+	const Cell& GetCell(const Elite::Vector2& point) const;
+
+	void Clear();
+private:
+	int GetCellIndex(const Elite::Vector2& point) const;
+	int GetColumn(float x) const;
+	int GetRow(float y) const;
+
+	Elite::Vector2 m_Origin{};
+	int m_NrColumns{};
+	int m_NrRows{};
+	std::vector<Cell> m_Cells{};
+
+	// The walls of a house lie on whole meters
+	constexpr static float m_CellSize{ 1.0f };
+	constexpr static short m_Outdoor{ -1 };
+};
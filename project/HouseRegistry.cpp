@@ -0,0 +1,157 @@
+#include "stdafx.h"
+#include "HouseRegistry.h"
+
+HouseRegistry::HouseRegistry(const WorldInfo& worldInfo)
+	: m_Grid{ worldInfo }
+{
+}
+
+int HouseRegistry::Add(const HouseInfo& house)
+{
+	// If the house is already known, return its id
+	const int knownId{ Find(house.Center) };
+	if (knownId >= 0) return knownId;
+
+	const int id{ static_cast<int>(m_Houses.size()) };
+
+	KnownHouse knownHouse{};
+	knownHouse.info = house;
+	knownHouse.min = house.Center - house.Size / 2.0f;
+	knownHouse.max = house.Center + house.Size / 2.0f;
+	m_Houses.push_back(knownHouse);
+
+	m_HouseIds[GetKey(house.Center)] = id;
+
+	// Add the house to every cell it overlaps
+	m_Grid.Rasterize(id, knownHouse.min, knownHouse.max);
+
+	return id;
+}
+
+int HouseRegistry::Find(const Elite::Vector2& center) const
+{
+	const long long x{ Quantize(center.x) };
+	const long long y{ Quantize(center.y) };
+
+	// Every sighting of a house on the fixed grid of the host has the same key
+	const auto it{ m_HouseIds.find(GetKey(x, y)) };
+	if (it != m_HouseIds.end()) return it->second;
+
+	// A close center can still round to a neighbouring key
+	for (long long offsetY{ -1 }; offsetY <= 1; ++offsetY)
+	{
+		for (long long offsetX{ -1 }; offsetX <= 1; ++offsetX)
+		{
+			const auto neighbour{ m_HouseIds.find(GetKey(x + offsetX, y + offsetY)) };
+			if (neighbour == m_HouseIds.end()) continue;
+
+			const Elite::Vector2& neighbourCenter{ m_Houses[neighbour->second].info.Center };
+			if (neighbourCenter.DistanceSquared(center) < m_CenterPrecision * m_CenterPrecision) return neighbour->second;
+		}
+	}
+
+	return -1;
+}
+
+bool HouseRegistry::IsKnown(const Elite::Vector2& center) const
+{
+	return Find(center) >= 0;
+}
+
+int HouseRegistry::GetHouseAt(const Elite::Vector2& point) const
+{
+	// Only the houses covering this cell can contain the point
+	const HouseGrid::Cell& cell{ m_Grid.GetCell(point) };
+
+	// Border cells are only partly covered by a house, a cell between two houses belongs to either one
+	if (Contains(cell.first, point)) return cell.first;
+	if (Contains(cell.second, point)) return cell.second;
+
+	return -1;
+}
+
+void HouseRegistry::GetHousesAt(const std::vector<EntityInfo>& entities, std::vector<int>& houseIds) const
+{
+	houseIds.resize(entities.size());
+	for (size_t i{}; i < entities.size(); ++i)
+	{
+		houseIds[i] = GetHouseAt(entities[i].Location);
+	}
+}
+
+KnownHouse& HouseRegistry::GetHouse(int id)
+{
+	return m_Houses[id];
+}
+
+const KnownHouse& HouseRegistry::GetHouse(int id) const
+{
+	return m_Houses[id];
+}
+
+const std::vector<KnownHouse>& HouseRegistry::GetHouses() const
+{
+	return m_Houses;
+}
+
+void HouseRegistry::AddFoundItem(const Elite::Vector2& location)
+{
+	const int id{ GetHouseAt(location) };
+	if (id >= 0) ++m_Houses[id].nrItemsFound;
+}
+
+void HouseRegistry::MarkVisited(int id, float time)
+{
+	KnownHouse& house{ m_Houses[id] };
+	house.visitRound = m_Round;
+	house.lastVisitTime = time;
+}
+
+bool HouseRegistry::IsVisited(int id) const
+{
+	return id >= 0 && m_Houses[id].visitRound == m_Round;
+}
+
+void HouseRegistry::StartNewRound()
+{
+	++m_Round;
+
+	// The loot state only describes the last visit
+	for (KnownHouse& house : m_Houses)
+	{
+		house.nrCornersVisited = 0;
+		house.nrItemsFound = 0;
+	}
+}
+
+void HouseRegistry::Clear()
+{
+	m_Houses.clear();
+	m_HouseIds.clear();
+	m_Grid.Clear();
+	m_Round = 0;
+}
+
+bool HouseRegistry::Contains(int id, const Elite::Vector2& point) const
+{
+	if (id < 0) return false;
+
+	const KnownHouse& house{ m_Houses[id] };
+	return point.x > house.min.x && point.x < house.max.x && point.y > house.min.y && point.y < house.max.y;
+}
+
+long long HouseRegistry::GetKey(const Elite::Vector2& center) const
+{
+	return GetKey(Quantize(center.x), Quantize(center.y));
+}
+
+long long HouseRegistry::GetKey(long long x, long long y) const
+{
+	// Pack both quantized coordinates in one key
+	return (x << 32) ^ (y & 0xFFFFFFFF);
+}
+
+long long HouseRegistry::Quantize(float coordinate) const
+{
+	return static_cast<long long>(roundf(coordinate / m_CenterPrecision));
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <unordered_map>
+#include "HouseGrid.h"
+
+// A house the agent has seen, with its bounds and how it was looted
+struct KnownHouse
+{
+	HouseInfo info{};
+	Elite::Vector2 min{};
+	Elite::Vector2 max{};
+
+	int nrCornersVisited{};
+	int nrItemsFound{};
+	float lastVisitTime{ -1.0f };
+
+	// The looting round in which the house was last visited, see HouseRegistry::StartNewRound
+	int visitRound{ -1 };
+};
+
+// Remembers every house that was seen, keyed by its quantized center
+// A grid over the world stores the house of each cell, so point queries only test the bounds of one house
+class HouseRegistry final
+{
+public:
+	HouseRegistry(const WorldInfo& worldInfo);
+
+	// Returns the id of the house, the house is added when it is not known yet
+	int Add(const HouseInfo& house);
+	// Returns the id of the house with this center, or -1 when it is unknown
+	int Find(const Elite::Vector2& center) const;
+	bool IsKnown(const Elite::Vector2& center) const;
+	// Returns the id of the house that contains the point, or -1 when the point is outside
+	int GetHouseAt(const Elite::Vector2& point) const;
+	// Finds the house of every entity at once, houseIds gets one id per entity (-1 for outdoor entities)
+	void GetHousesAt(const std::vector<EntityInfo>& entities, std::vector<int>& houseIds) const;
+
+	KnownHouse& GetHouse(int id);
+	const KnownHouse& GetHouse(int id) const;
+	const std::vector<KnownHouse>& GetHouses() const;
+
+	// Counts an item for the house it lies in, items outside houses are ignored
+	void AddFoundItem(const Elite::Vector2& location);
+
+	// Visits only count for the current round, a new round makes every house unvisited again
+	void MarkVisited(int id, float time);
+	bool IsVisited(int id) const;
+	void StartNewRound();
+
+	void Clear();
+private:
+	long long GetKey(const Elite::Vector2& center) const;
+	long long GetKey(long long x, long long y) const;
+	long long Quantize(float coordinate) const;
+	bool Contains(int id, const Elite::Vector2& point) const;
+
+	std::vector<KnownHouse> m_Houses{};
+	std::unordered_map<long long, int> m_HouseIds{};
+	int m_Round{};
+
+	// Spatial index
+	HouseGrid m_Grid;
+
+	// Centers closer than this to each other are the same house, so are centers that quantize to the same key
+	constexpr static float m_CenterPrecision{ 0.5f };
+};
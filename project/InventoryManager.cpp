@@ -228,6 +228,24 @@ bool InventoryManager::ShootShotgun()
 	return false;
 }
 
+bool InventoryManager::UseItem(eItemType type)
+{
+	// For each item
+	for (UINT i{}; i < m_InventoryAmount; ++i)
+	{
+		// If the item is not of the requested type, continue to the next item
+		if (m_Inventory[i].Type != type) continue;
+
+		// Use and remove the item
+		if (!m_pInterface->Inventory_UseItem(i)) return false;
+		m_pInterface->Inventory_RemoveItem(i);
+		m_Inventory[i].Type = eItemType::_LAST;
+
+		return true;
+	}
+	return false;
+}
+
 UINT InventoryManager::IsBetterInventoryPossible(const EntityInfo& entity, const std::vector<FoundEntityInfo>& foundEntities) const
 {
 	ItemInfo itemInfo;
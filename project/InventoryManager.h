@@ -16,6 +16,7 @@ public:
 
 	bool ShootPistol();
 	bool ShootShotgun();
+	bool UseItem(eItemType type);
 	UINT IsBetterInventoryPossible(const EntityInfo& entity, const std::vector<FoundEntityInfo>& foundEntities) const;
 	bool IsInventoryFull() const;
 	bool HasMedkit() const;
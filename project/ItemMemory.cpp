@@ -0,0 +1,160 @@
+#include "stdafx.h"
+#include "ItemMemory.h"
+#include "Perception.h"
+
+ItemMemory::ItemMemory(size_t capacity)
+	: m_Capacity{ capacity }
+{
+	m_Items.reserve(capacity);
+	m_LastSeen.reserve(capacity);
+
+	// A power of two of at least twice the capacity, so a probe rarely passes more than a few slots
+	size_t nrSlots{ 1 };
+	while (nrSlots < capacity * 2) nrSlots *= 2;
+	m_Slots.resize(nrSlots);
+	m_SlotMask = nrSlots - 1;
+}
+
+void ItemMemory::Update(const Perception& perception)
+{
+	++m_Frame;
+
+	for (UINT index : perception.GetItems())
+	{
+		const int itemIndex{ Find(perception.GetEntity(index).EntityHash) };
+		if (itemIndex >= 0) m_LastSeen[itemIndex] = m_Frame;
+	}
+}
+
+bool ItemMemory::Add(const FoundEntityInfo& item)
+{
+	if (Contains(item.EntityHash)) return false;
+
+	// Make room by forgetting the item that is worth the least
+	if (m_Items.size() >= m_Capacity) RemoveAt(GetLeastWorthItem());
+
+	const UINT itemIndex{ static_cast<UINT>(m_Items.size()) };
+	m_Items.push_back(item);
+	m_LastSeen.push_back(m_Frame);
+	m_Slots[FindSlot(item.EntityHash)] = Slot{ item.EntityHash, itemIndex };
+	return true;
+}
+
+bool ItemMemory::Remove(int hash)
+{
+	const int itemIndex{ Find(hash) };
+	if (itemIndex < 0) return false;
+
+	RemoveAt(static_cast<UINT>(itemIndex));
+	return true;
+}
+
+void ItemMemory::RemoveGarbage()
+{
+	// Removing moves the last item into the gap, going backwards every item is still checked once
+	for (size_t i{ m_Items.size() }; i > 0; --i)
+	{
+		if (m_Items[i - 1].itemType == eItemType::GARBAGE) RemoveAt(static_cast<UINT>(i - 1));
+	}
+}
+
+void ItemMemory::Clear()
+{
+	m_NrRemoved += m_Items.size();
+	m_Items.clear();
+	m_LastSeen.clear();
+	std::fill(m_Slots.begin(), m_Slots.end(), Slot{});
+}
+
+bool ItemMemory::Contains(int hash) const
+{
+	return Find(hash) >= 0;
+}
+
+int ItemMemory::Find(int hash) const
+{
+	const Slot& slot{ m_Slots[FindSlot(hash)] };
+	return slot.itemIndex == m_EmptySlot ? -1 : static_cast<int>(slot.itemIndex);
+}
+
+const std::vector<FoundEntityInfo>& ItemMemory::GetItems() const
+{
+	return m_Items;
+}
+
+size_t ItemMemory::GetNrRemoved() const
+{
+	return m_NrRemoved;
+}
+
+size_t ItemMemory::GetCapacity() const
+{
+	return m_Capacity;
+}
+
+size_t ItemMemory::GetHomeSlot(int hash) const
+{
+	// Hashes of items that are found together are often close to each other, mix the bits before using the low ones
+	UINT mixed{ static_cast<UINT>(hash) };
+	mixed ^= mixed >> 16;
+	mixed *= 0x45d9f3bu;
+	mixed ^= mixed >> 16;
+	return mixed & m_SlotMask;
+}
+
+size_t ItemMemory::FindSlot(int hash) const
+{
+	size_t slot{ GetHomeSlot(hash) };
+	while (m_Slots[slot].itemIndex != m_EmptySlot && m_Slots[slot].hash != hash)
+	{
+		slot = (slot + 1) & m_SlotMask;
+	}
+	return slot;
+}
+
+void ItemMemory::RemoveAt(UINT itemIndex)
+{
+	// Free the slot, later slots of the same probe are moved back so every item stays reachable from its home slot
+	size_t hole{ FindSlot(m_Items[itemIndex].EntityHash) };
+	for (size_t slot{ (hole + 1) & m_SlotMask }; m_Slots[slot].itemIndex != m_EmptySlot; slot = (slot + 1) & m_SlotMask)
+	{
+		const size_t homeSlot{ GetHomeSlot(m_Slots[slot].hash) };
+		if (((slot - homeSlot) & m_SlotMask) < ((slot - hole) & m_SlotMask)) continue;
+
+		m_Slots[hole] = m_Slots[slot];
+		hole = slot;
+	}
+	m_Slots[hole] = Slot{};
+
+	// Move the last item into the gap
+	const UINT lastIndex{ static_cast<UINT>(m_Items.size() - 1) };
+	if (itemIndex != lastIndex)
+	{
+		m_Items[itemIndex] = m_Items[lastIndex];
+		m_LastSeen[itemIndex] = m_LastSeen[lastIndex];
+		m_Slots[FindSlot(m_Items[itemIndex].EntityHash)].itemIndex = itemIndex;
+	}
+	m_Items.pop_back();
+	m_LastSeen.pop_back();
+
+	++m_NrRemoved;
+}
+
+UINT ItemMemory::GetLeastWorthItem() const
+{
+	// Only runs when the memory is full, a new item is not found every frame
+	UINT leastWorthIndex{};
+	for (UINT i{ 1 }; i < m_Items.size(); ++i)
+	{
+		const bool hasValue{ m_Items[i].value > 0 };
+		const bool leastHasValue{ m_Items[leastWorthIndex].value > 0 };
+		if (hasValue != leastHasValue)
+		{
+			if (!hasValue) leastWorthIndex = i;
+			continue;
+		}
+
+		if (m_LastSeen[i] < m_LastSeen[leastWorthIndex]) leastWorthIndex = i;
+	}
+	return leastWorthIndex;
+}
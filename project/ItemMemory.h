@@ -0,0 +1,59 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include "ExtendedStructs.h"
+
+class Perception;
+
+// Remembers the items the agent has seen, keyed by their EntityHash
+// The items live in one array of a fixed capacity, so remembering never allocates and a lookup is one probe of a hash table
+// When the memory is full, the item that is worth the least is forgotten: items without value first, then the one that was seen the longest ago
+class ItemMemory final
+{
+public:
+	explicit ItemMemory(size_t capacity);
+
+	// Marks every remembered item in fov as seen this frame
+	void Update(const Perception& perception);
+
+	// Returns false when the item is already remembered
+	bool Add(const FoundEntityInfo& item);
+	// Returns false when the item is not remembered
+	bool Remove(int hash);
+	void RemoveGarbage();
+	void Clear();
+
+	bool Contains(int hash) const;
+	// Returns the index of the item, or -1 when it is not remembered
+	int Find(int hash) const;
+
+	// Items keep their index until an item is removed, new items are always added at the end
+	const std::vector<FoundEntityInfo>& GetItems() const;
+	// Counts every removal, so users of the indices know when they changed
+	size_t GetNrRemoved() const;
+	size_t GetCapacity() const;
+private:
+	constexpr static UINT m_EmptySlot{ UINT_MAX };
+
+	struct Slot
+	{
+		int hash{};
+		UINT itemIndex{ m_EmptySlot };
+	};
+
+	size_t GetHomeSlot(int hash) const;
+	// Returns the slot of the hash, or the empty slot where it would go
+	size_t FindSlot(int hash) const;
+	void RemoveAt(UINT itemIndex);
+	UINT GetLeastWorthItem() const;
+
+	std::vector<FoundEntityInfo> m_Items{};
+	// The frame every item was last seen, next to the items
+	std::vector<UINT> m_LastSeen{};
+	UINT m_Frame{};
+	size_t m_Capacity{};
+	size_t m_NrRemoved{};
+
+	// Open addressing with linear probing, the table is at most half full
+	std::vector<Slot> m_Slots{};
+	size_t m_SlotMask{};
+};
@@ -0,0 +1,80 @@
+#include "stdafx.h"
+#include "LevelFile.h"
+
+namespace
+{
+	template<typename T>
+	bool Read(std::ifstream& file, T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+bool LevelFile::Load(const std::string& filePath)
+{
+	m_Houses.clear();
+
+	std::ifstream file{ filePath, std::ios::binary };
+	if (!file.is_open())
+	{
+		std::cout << "Could not open level file " << filePath << "\n";
+		return false;
+	}
+
+	// The world is centered around the origin
+	m_WorldInfo.Center = Elite::Vector2{};
+	int nrHouses{};
+	if (!Read(file, m_WorldInfo.Dimensions.x) || !Read(file, m_WorldInfo.Dimensions.y) || !Read(file, nrHouses)
+		|| nrHouses < 0 || nrHouses > m_MaxCount)
+	{
+		std::cout << "Level file " << filePath << " has an invalid header\n";
+		return false;
+	}
+
+	// Read every house
+	m_Houses.resize(nrHouses);
+	for (LevelHouse& house : m_Houses)
+	{
+		if (!Read(file, house.info.Center.x) || !Read(file, house.info.Center.y)
+			|| !Read(file, house.info.Size.x) || !Read(file, house.info.Size.y)
+			|| !ReadPolygons(file, house.walls) || !ReadPolygons(file, house.outlines))
+		{
+			std::cout << "Level file " << filePath << " ends in the middle of a house\n";
+			m_Houses.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const WorldInfo& LevelFile::GetWorldInfo() const
+{
+	return m_WorldInfo;
+}
+
+const std::vector<LevelHouse>& LevelFile::GetHouses() const
+{
+	return m_Houses;
+}
+
+bool LevelFile::ReadPolygons(std::ifstream& file, std::vector<std::vector<Elite::Vector2>>& polygons)
+{
+	int nrPolygons{};
+	if (!Read(file, nrPolygons) || nrPolygons < 0 || nrPolygons > m_MaxCount) return false;
+
+	polygons.resize(nrPolygons);
+	for (std::vector<Elite::Vector2>& polygon : polygons)
+	{
+		int nrPoints{};
+		if (!Read(file, nrPoints) || nrPoints < 0 || nrPoints > m_MaxCount) return false;
+
+		polygon.resize(nrPoints);
+		for (Elite::Vector2& point : polygon)
+		{
+			if (!Read(file, point.x) || !Read(file, point.y)) return false;
+		}
+	}
+
+	return true;
+}
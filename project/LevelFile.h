@@ -0,0 +1,30 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+
+// A house as it is stored in a .gppl level file
+struct LevelHouse
+{
+	HouseInfo info{};
+	std::vector<std::vector<Elite::Vector2>> walls{}; // One rectangle per wall
+	std::vector<std::vector<Elite::Vector2>> outlines{}; // The walls merged into closed outlines
+};
+
+// Reads the binary .gppl level files of the exam framework
+// Layout: world width, world height, house count, then per house:
+// center, size, wall count, walls, outline count, outlines (a polygon is a point count followed by the points)
+class LevelFile final
+{
+public:
+	bool Load(const std::string& filePath);
+
+	const WorldInfo& GetWorldInfo() const;
+	const std::vector<LevelHouse>& GetHouses() const;
+private:
+	WorldInfo m_WorldInfo{};
+	std::vector<LevelHouse> m_Houses{};
+
+	static bool ReadPolygons(std::ifstream& file, std::vector<std::vector<Elite::Vector2>>& polygons);
+
+	// Anything bigger than this is not a valid level file
+	constexpr static int m_MaxCount{ 4096 };
+};
@@ -0,0 +1,273 @@
+#include "stdafx.h"
+#include "LootTourPlanner.h"
+
+void LootTourPlanner::Update(const Elite::Vector2& agentPosition, const ItemMemory& memory, std::span<const eItemType> neededTypes, float maxRange)
+{
+	const std::vector<FoundEntityInfo>& items{ memory.GetItems() };
+	m_MaxRange = maxRange;
+
+	// Forgotten items or other needs make the whole route invalid
+	if (!std::equal(neededTypes.begin(), neededTypes.end(), m_NeededTypes.begin(), m_NeededTypes.end()) || memory.GetNrRemoved() != m_NrRemoved || !IsValid(items))
+	{
+		m_NeededTypes.assign(neededTypes.begin(), neededTypes.end());
+		m_NrRemoved = memory.GetNrRemoved();
+		Rebuild(agentPosition, items, maxRange);
+	}
+	else if (items.size() > m_NrItems)
+	{
+		// Without removals, remembered items are only ever appended, so only the last ones are new
+		for (size_t i{ m_NrItems }; i < items.size(); ++i)
+		{
+			if (!IsCandidate(agentPosition, items[i], maxRange)) continue;
+
+			m_Candidates.push_back(static_cast<UINT>(i));
+			Insert(agentPosition, static_cast<UINT>(i), items[i]);
+		}
+	}
+	else
+	{
+		return;
+	}
+
+	m_NrItems = items.size();
+
+	Improve(agentPosition, items);
+	StoreStops();
+}
+
+bool LootTourPlanner::IsEmpty() const
+{
+	return m_Stops.empty();
+}
+
+const Elite::Vector2& LootTourPlanner::GetNextStop() const
+{
+	return m_Stops.front();
+}
+
+const std::vector<Elite::Vector2>& LootTourPlanner::GetStops() const
+{
+	return m_Stops;
+}
+
+void LootTourPlanner::DrawDebug(IExamInterface* pInterface, const Elite::Vector2& agentPosition) const
+{
+	// Nothing was planned yet
+	if (m_MaxRange <= 0.0f) return;
+
+	pInterface->Draw_Circle(agentPosition, m_MaxRange, { 0.0f, 0.0f, 1.0f });
+
+	Elite::Vector2 position{ agentPosition };
+	for (const Elite::Vector2& stop : m_Stops)
+	{
+		pInterface->Draw_Segment(position, stop, { 0.0f, 0.0f, 1.0f });
+		position = stop;
+	}
+}
+
+bool LootTourPlanner::IsValid(const std::vector<FoundEntityInfo>& items) const
+{
+	// Every stop should still point to the same item
+	for (const Stop& stop : m_Route)
+	{
+		if (stop.itemIndex >= items.size()) return false;
+		if (items[stop.itemIndex].Location.DistanceSquared(stop.location) > FLT_EPSILON) return false;
+	}
+
+	return true;
+}
+
+bool LootTourPlanner::IsCandidate(const Elite::Vector2& agentPosition, const FoundEntityInfo& item, float maxRange) const
+{
+	if (std::find(m_NeededTypes.begin(), m_NeededTypes.end(), item.itemType) == m_NeededTypes.end()) return false;
+
+	// Food is always worth the walk
+	return item.itemType == eItemType::FOOD || agentPosition.DistanceSquared(item.Location) <= maxRange * maxRange;
+}
+
+void LootTourPlanner::Rebuild(const Elite::Vector2& agentPosition, const std::vector<FoundEntityInfo>& items, float maxRange)
+{
+	m_Route.clear();
+	m_Candidates.clear();
+
+	for (UINT i{}; i < items.size(); ++i)
+	{
+		if (IsCandidate(agentPosition, items[i], maxRange)) m_Candidates.push_back(i);
+	}
+
+	// Nearest neighbor: walk to the closest item of a type that is not on the route yet
+	m_RemainingTypes.assign(m_NeededTypes.begin(), m_NeededTypes.end());
+	Elite::Vector2 position{ agentPosition };
+
+	while (!m_RemainingTypes.empty())
+	{
+		int closestItem{ -1 };
+		float closestDistance{ FLT_MAX };
+
+		for (UINT index : m_Candidates)
+		{
+			const FoundEntityInfo& item{ items[index] };
+			if (std::find(m_RemainingTypes.begin(), m_RemainingTypes.end(), item.itemType) == m_RemainingTypes.end()) continue;
+
+			const float distance{ position.DistanceSquared(item.Location) };
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				closestItem = static_cast<int>(index);
+			}
+		}
+
+		// None of the remaining types is remembered
+		if (closestItem < 0) break;
+
+		const FoundEntityInfo& item{ items[closestItem] };
+		m_Route.push_back(Stop{ static_cast<UINT>(closestItem), item.Location, item.itemType });
+		m_RemainingTypes.erase(std::find(m_RemainingTypes.begin(), m_RemainingTypes.end(), item.itemType));
+		position = item.Location;
+	}
+}
+
+void LootTourPlanner::Insert(const Elite::Vector2& agentPosition, UINT itemIndex, const FoundEntityInfo& item)
+{
+	const Stop newStop{ itemIndex, item.Location, item.itemType };
+
+	// If this type already has a stop, the new item can only replace it
+	const auto sameType{ std::find_if(m_Route.begin(), m_Route.end(), [&item](const Stop& stop) { return stop.type == item.itemType; }) };
+	if (sameType != m_Route.end())
+	{
+		Replace(agentPosition, static_cast<size_t>(sameType - m_Route.begin()), newStop);
+		return;
+	}
+
+	InsertAtBest(agentPosition, newStop);
+}
+
+bool LootTourPlanner::Replace(const Elite::Vector2& agentPosition, size_t routeIndex, const Stop& newStop)
+{
+	m_SavedRoute.assign(m_Route.begin(), m_Route.end());
+	const float oldLength{ GetLength(agentPosition) };
+
+	// The new stop does not have to be at the same place on the route
+	m_Route.erase(m_Route.begin() + routeIndex);
+	if (InsertAtBest(agentPosition, newStop) < oldLength) return true;
+
+	m_Route.assign(m_SavedRoute.begin(), m_SavedRoute.end());
+	return false;
+}
+
+float LootTourPlanner::InsertAtBest(const Elite::Vector2& agentPosition, const Stop& newStop)
+{
+	// Add the stop where it makes the route the least longer
+	size_t bestPosition{};
+	float bestLength{ FLT_MAX };
+	for (size_t i{}; i <= m_Route.size(); ++i)
+	{
+		m_Route.insert(m_Route.begin() + i, newStop);
+
+		const float length{ GetLength(agentPosition) };
+		if (length < bestLength)
+		{
+			bestLength = length;
+			bestPosition = i;
+		}
+
+		m_Route.erase(m_Route.begin() + i);
+	}
+
+	m_Route.insert(m_Route.begin() + bestPosition, newStop);
+	return bestLength;
+}
+
+void LootTourPlanner::Improve(const Elite::Vector2& agentPosition, const std::vector<FoundEntityInfo>& items)
+{
+	float length{ GetLength(agentPosition) };
+
+	for (int pass{}; pass < m_MaxImprovePasses; ++pass)
+	{
+		bool isImproved{};
+
+		// 2-opt: reverse a part of the route when that makes it shorter, the route starts at the agent and is open at the end
+		for (size_t i{}; i + 1 < m_Route.size(); ++i)
+		{
+			for (size_t j{ i + 1 }; j < m_Route.size(); ++j)
+			{
+				std::reverse(m_Route.begin() + i, m_Route.begin() + j + 1);
+
+				const float newLength{ GetLength(agentPosition) };
+				if (newLength < length)
+				{
+					length = newLength;
+					isImproved = true;
+				}
+				else
+				{
+					std::reverse(m_Route.begin() + i, m_Route.begin() + j + 1);
+				}
+			}
+		}
+
+		// Or-opt: move a single stop to another place on the route, 2-opt alone can not move a stop to the start
+		for (size_t from{}; from < m_Route.size(); ++from)
+		{
+			for (size_t to{}; to < m_Route.size(); ++to)
+			{
+				if (from == to) continue;
+
+				const Stop stop{ m_Route[from] };
+				m_Route.erase(m_Route.begin() + from);
+				m_Route.insert(m_Route.begin() + to, stop);
+
+				const float newLength{ GetLength(agentPosition) };
+				if (newLength < length)
+				{
+					length = newLength;
+					isImproved = true;
+				}
+				else
+				{
+					m_Route.erase(m_Route.begin() + to);
+					m_Route.insert(m_Route.begin() + from, stop);
+				}
+			}
+		}
+
+		// Swap a stop for another item of the same type when that makes the route shorter
+		for (size_t k{}; k < m_Route.size(); ++k)
+		{
+			for (UINT index : m_Candidates)
+			{
+				const FoundEntityInfo& item{ items[index] };
+				if (item.itemType != m_Route[k].type || index == m_Route[k].itemIndex) continue;
+
+				if (Replace(agentPosition, k, Stop{ index, item.Location, item.itemType }))
+				{
+					length = GetLength(agentPosition);
+					isImproved = true;
+				}
+			}
+		}
+
+		if (!isImproved) break;
+	}
+}
+
+float LootTourPlanner::GetLength(const Elite::Vector2& agentPosition) const
+{
+	float length{};
+	Elite::Vector2 position{ agentPosition };
+	for (const Stop& stop : m_Route)
+	{
+		length += position.Distance(stop.location);
+		position = stop.location;
+	}
+	return length;
+}
+
+void LootTourPlanner::StoreStops()
+{
+	m_Stops.clear();
+	for (const Stop& stop : m_Route)
+	{
+		m_Stops.push_back(stop.location);
+	}
+}
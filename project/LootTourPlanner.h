@@ -0,0 +1,60 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <IExamInterface.h>
+#include "ExtendedStructs.h"
+#include "ItemMemory.h"
+#include <span>
+
+// Plans a short route past the remembered items that fill the inventory
+// Only one item of every needed type is picked, the route is built nearest neighbor first and shortened with 2-opt and or-opt
+// New items only try to improve the current route, the route is only built again when items are forgotten or the needs change
+class LootTourPlanner final
+{
+public:
+	// The needed types are ordered from most to least needed, food is fetched at any distance
+	void Update(const Elite::Vector2& agentPosition, const ItemMemory& memory, std::span<const eItemType> neededTypes, float maxRange);
+
+	bool IsEmpty() const;
+	const Elite::Vector2& GetNextStop() const;
+	const std::vector<Elite::Vector2>& GetStops() const;
+
+	// Draws the range the last update looked in and the route from the agent past every stop
+	void DrawDebug(IExamInterface* pInterface, const Elite::Vector2& agentPosition) const;
+private:
+	struct Stop
+	{
+		UINT itemIndex{};
+		Elite::Vector2 location{};
+		eItemType type{};
+	};
+
+	bool IsValid(const std::vector<FoundEntityInfo>& items) const;
+	bool IsCandidate(const Elite::Vector2& agentPosition, const FoundEntityInfo& item, float maxRange) const;
+
+	void Rebuild(const Elite::Vector2& agentPosition, const std::vector<FoundEntityInfo>& items, float maxRange);
+	void Insert(const Elite::Vector2& agentPosition, UINT itemIndex, const FoundEntityInfo& item);
+	// Swaps the stop for the new one if the route gets shorter
+	bool Replace(const Elite::Vector2& agentPosition, size_t routeIndex, const Stop& newStop);
+	// Returns the length of the route with the stop added
+	float InsertAtBest(const Elite::Vector2& agentPosition, const Stop& newStop);
+	void Improve(const Elite::Vector2& agentPosition, const std::vector<FoundEntityInfo>& items);
+
+	float GetLength(const Elite::Vector2& agentPosition) const;
+	void StoreStops();
+
+	std::vector<Stop> m_Route{};
+	std::vector<Elite::Vector2> m_Stops{};
+	// Every remembered item that could replace the stop of its type
+	std::vector<UINT> m_Candidates{};
+	// Scratch space of Replace and Rebuild, kept between updates so they do not allocate again
+	std::vector<Stop> m_SavedRoute{};
+	std::vector<eItemType> m_RemainingTypes{};
+
+	std::vector<eItemType> m_NeededTypes{};
+	float m_MaxRange{};
+	size_t m_NrItems{};
+	size_t m_NrRemoved{};
+
+	// The improvement stops after this many passes, so one frame never takes long
+	constexpr static int m_MaxImprovePasses{ 4 };
+};
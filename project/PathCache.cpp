@@ -0,0 +1,37 @@
+#include "stdafx.h"
+#include "PathCache.h"
+#include <IExamInterface.h>
+
+bool PathCache::GetPathPoint(Elite::Blackboard* pBlackboard, const std::string& targetField, IExamInterface* pInterface, const Elite::Vector2& agentPosition, Elite::Vector2& pathPoint)
+{
+	// A version of 0 means the field does not exist
+	const unsigned int targetVersion{ pBlackboard->GetVersion(targetField) };
+	if (targetVersion == 0) return false;
+
+	CachedPath& path{ m_Paths[targetField] };
+
+	// Reuse the point while the target is the same and the agent is still on its way to it
+	if (path.targetVersion == targetVersion
+		&& agentPosition.DistanceSquared(path.pathPoint) > m_ArriveRadius * m_ArriveRadius
+		&& agentPosition.DistanceSquared(path.searchPosition) < m_MaxDrift * m_MaxDrift)
+	{
+		pathPoint = path.pathPoint;
+		return true;
+	}
+
+	Elite::Vector2 target;
+	if (!pBlackboard->GetData(targetField, target)) return false;
+
+	// Search the path again
+	path.targetVersion = targetVersion;
+	path.searchPosition = agentPosition;
+	path.pathPoint = pInterface->NavMesh_GetClosestPathPoint(target);
+
+	pathPoint = path.pathPoint;
+	return true;
+}
+
+void PathCache::Clear()
+{
+	m_Paths.clear();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <unordered_map>
+#include "EBlackboard.h"
+
+class IExamInterface;
+
+// Remembers the next navmesh path point towards the target in a blackboard field
+// The path is only searched again when the target field changed, the point is reached or the agent drifted away from where it was searched
+class PathCache final
+{
+public:
+	// Returns false when the target field is not in the blackboard
+	bool GetPathPoint(Elite::Blackboard* pBlackboard, const std::string& targetField, IExamInterface* pInterface, const Elite::Vector2& agentPosition, Elite::Vector2& pathPoint);
+
+	void Clear();
+private:
+	struct CachedPath
+	{
+		unsigned int targetVersion{};
+		Elite::Vector2 searchPosition{};
+		Elite::Vector2 pathPoint{};
+	};
+
+	std::unordered_map<std::string, CachedPath> m_Paths{};
+
+	// Closer than this to the path point, the next point of the path is needed
+	constexpr static float m_ArriveRadius{ 2.0f };
+	// The path point is only known to be reachable close to where it was searched
+	constexpr static float m_MaxDrift{ 2.0f };
+};
@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "Perception.h"
+#include "HouseRegistry.h"
+
+void Perception::Update(const std::vector<EntityInfo>& entitiesInFov, const Elite::Vector2& agentPosition, const HouseRegistry& houses)
+{
+	// Keep a copy, so the views stay valid when the fov container changes
+	m_Entities = entitiesInFov;
+
+	m_Items.clear();
+	m_Enemies.clear();
+	m_PurgeZones.clear();
+
+	// Calculate every distance only once
+	m_DistancesSquared.resize(m_Entities.size());
+	for (UINT i{}; i < m_Entities.size(); ++i)
+	{
+		const EntityInfo& entity{ m_Entities[i] };
+		m_DistancesSquared[i] = agentPosition.DistanceSquared(entity.Location);
+
+		switch (entity.Type)
+		{
+		case eEntityType::ITEM:
+			m_Items.push_back(i);
+			break;
+		case eEntityType::ENEMY:
+			m_Enemies.push_back(i);
+			break;
+		case eEntityType::PURGEZONE:
+			m_PurgeZones.push_back(i);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Classify every entity as indoor or outdoor in one pass
+	houses.GetHousesAt(m_Entities, m_HouseIds);
+
+	SortView(m_Items);
+	SortView(m_Enemies);
+	SortView(m_PurgeZones);
+}
+
+const std::vector<UINT>& Perception::GetItems() const
+{
+	return m_Items;
+}
+
+const std::vector<UINT>& Perception::GetEnemies() const
+{
+	return m_Enemies;
+}
+
+const std::vector<UINT>& Perception::GetPurgeZones() const
+{
+	return m_PurgeZones;
+}
+
+size_t Perception::GetNrSorted(const std::vector<UINT>& view) const
+{
+	return std::min(view.size(), m_MaxSorted);
+}
+
+const EntityInfo& Perception::GetEntity(UINT index) const
+{
+	return m_Entities[index];
+}
+
+float Perception::GetDistanceSquared(UINT index) const
+{
+	return m_DistancesSquared[index];
+}
+
+int Perception::GetHouseId(UINT index) const
+{
+	return m_HouseIds[index];
+}
+
+bool Perception::IsIndoor(UINT index) const
+{
+	return m_HouseIds[index] >= 0;
+}
+
+void Perception::SortView(std::vector<UINT>& view) const
+{
+	const auto isCloser{ [this](UINT a, UINT b) { return m_DistancesSquared[a] < m_DistancesSquared[b]; } };
+
+	// Only order the closest entities, the others are only split off
+	const auto sortedEnd{ view.begin() + GetNrSorted(view) };
+	std::partial_sort(view.begin(), sortedEnd, view.end(), isCloser);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+
+class HouseRegistry;
+
+// Orders what the agent sees once per frame, so behaviors do not have to search or sort the fov themselves
+// Every entity type gets its own view: indices into the fov entities, closest to the agent first
+class Perception final
+{
+public:
+	void Update(const std::vector<EntityInfo>& entitiesInFov, const Elite::Vector2& agentPosition, const HouseRegistry& houses);
+
+	const std::vector<UINT>& GetItems() const;
+	const std::vector<UINT>& GetEnemies() const;
+	const std::vector<UINT>& GetPurgeZones() const;
+
+	// Only the first entries of a view are in order, the rest is further away in no particular order
+	size_t GetNrSorted(const std::vector<UINT>& view) const;
+
+	const EntityInfo& GetEntity(UINT index) const;
+	float GetDistanceSquared(UINT index) const;
+	// The id of the known house the entity lies in, or -1 when it is outdoors
+	int GetHouseId(UINT index) const;
+	bool IsIndoor(UINT index) const;
+private:
+	void SortView(std::vector<UINT>& view) const;
+
+	std::vector<EntityInfo> m_Entities{};
+	std::vector<float> m_DistancesSquared{};
+	std::vector<int> m_HouseIds{};
+
+	std::vector<UINT> m_Items{};
+	std::vector<UINT> m_Enemies{};
+	std::vector<UINT> m_PurgeZones{};
+
+	// Behaviors only ever need the closest few entities
+	constexpr static size_t m_MaxSorted{ 16 };
+};
@@ -7,6 +7,11 @@
 
 using namespace std;
 
+IPluginBase* Register()
+{
+	return new Plugin();
+}
+
 //Called only once, during initialization
 void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 {
@@ -21,199 +26,381 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 	info.Student_LastName = "De Keukelaere";
 	info.Student_Class = "2DAE15";
 
+	// Release everything from a previous initialization
+	Release();
+
 	const WorldInfo worldInfo{ m_pInterface->World_GetInfo() };
 	m_pExplorer = new WorldExplorer{ worldInfo };
+	m_pHouses = new HouseRegistry{ worldInfo };
 
 	m_pInventoryManager = new InventoryManager{ m_pInterface };
 
 	m_pSteering = new Steering{};
+	m_pSteering->SetMode(Steering::Mode::Context);
+
+	// Expensive queries are spread over multiple frames, each frame gets a fixed amount of time
+	constexpr long long taskBudgetMicroseconds{ 200 };
+	m_pScheduler = new TaskScheduler{ taskBudgetMicroseconds };
+
+	m_pPerception = new Perception{};
+
+	m_pSweepPlanner = new SweepPlanner{};
+	m_pLootTour = new LootTourPlanner{};
+	m_pEnemyTracker = new EnemyTracker{};
+	m_pEnemyPredictor = new EnemyPredictor{ m_pEnemyTracker };
+	m_pPathCache = new PathCache{};
+
+	// Big enough for a normal frame, the arena grows when a frame needs more
+	constexpr size_t frameArenaCapacity{ 16 * 1024 };
+	m_pFrameArena = new FrameArena{ frameArenaCapacity };
+
+	// More items than a long run remembers at once, the least worth ones are forgotten beyond this
+	constexpr size_t itemMemoryCapacity{ 256 };
+	m_pItemMemory = new ItemMemory{ itemMemoryCapacity };
 
 	Elite::Blackboard* pBlackboard = new Elite::Blackboard();
 	pBlackboard->AddData("Interface", m_pInterface);
 	pBlackboard->AddData("Explorer", m_pExplorer);
 	pBlackboard->AddData("Inventory", m_pInventoryManager);
 	pBlackboard->AddData("HouseFovVec", &m_HousesInFOV);
-	pBlackboard->AddData("HouseAllVec", &m_Houses);
+	pBlackboard->AddData("Houses", m_pHouses);
 	pBlackboard->AddData("EntityFovVec", &m_EntitiesInFOV);
-	pBlackboard->AddData("EntityAllVec", &m_Entities);
+	pBlackboard->AddData("ItemMemory", m_pItemMemory);
 	pBlackboard->AddData("CurHouse", CurrentHouse{});
 	pBlackboard->AddData("CurLoot", EntityInfo{});
 	pBlackboard->AddData("HouseTarget", Elite::Vector2{});
 	pBlackboard->AddData("EntityTarget", Elite::Vector2{});
 	pBlackboard->AddData("Steering", m_pSteering);
+	pBlackboard->AddData("Scheduler", m_pScheduler);
+	pBlackboard->AddData("Perception", m_pPerception);
+	pBlackboard->AddData("SweepPlanner", m_pSweepPlanner);
+	pBlackboard->AddData("LootTour", m_pLootTour);
+	pBlackboard->AddData("EnemyTracker", m_pEnemyTracker);
+	pBlackboard->AddData("EnemyPredictor", m_pEnemyPredictor);
+	pBlackboard->AddData("PathCache", m_pPathCache);
+	pBlackboard->AddData("FrameArena", m_pFrameArena);
 	pBlackboard->AddData("ReplaceIndex", UINT(0));
 	pBlackboard->AddData("LookingForEnemy", false);
-	pBlackboard->AddData("LookForEnemyTimer", 0.0f);
 	pBlackboard->AddData("DeltaTime", 0.0f);
+	pBlackboard->AddData("AgentInfo", &m_AgentInfo);
 	
-	Elite::BehaviorTree* pBehaviorTree
+	// Create the decision making, it takes ownership of the blackboard
+	switch (m_DecisionMakingType)
+	{
+	case DecisionMakingType::BehaviorTree:
+		m_DecisionTree = CreateBehaviorTree(pBlackboard);
+		m_pDecisionMaking = m_DecisionTree;
+		break;
+	case DecisionMakingType::Utility:
+		m_pDecisionMaking = CreateUtilityDecisionMaking(pBlackboard);
+		break;
+	case DecisionMakingType::GOAP:
+		m_pDecisionMaking = CreateGOAPDecisionMaking(pBlackboard);
+		break;
+	}
+}
+
+Elite::BehaviorTree* Plugin::CreateBehaviorTree(Elite::Blackboard* pBlackboard)
+{
+	// Every node of the tree is created inside the arena, the tree releases it in one go
+	// The tree file is used when it is valid, else fall back to the built-in tree
+	m_pTreeLoader = new BehaviorTreeLoader{ "BehaviorTree.txt" };
+	BT_Registry::RegisterBehaviors(*m_pTreeLoader);
+
+	Elite::BehaviorArena* pArena{ new Elite::BehaviorArena{} };
+	Elite::IBehavior* pRootBehavior{ m_pTreeLoader->Load(*pArena) };
+	if (!pRootBehavior)
+	{
+		std::cout << "Using the built-in behavior tree\n";
+
+		pArena->Clear();
+		pRootBehavior = CreateDefaultBehavior(*pArena);
+	}
+
+	return new Elite::BehaviorTree{ pBlackboard, pArena, pRootBehavior };
+}
+
+Elite::UtilityDecisionMaker* Plugin::CreateUtilityDecisionMaking(Elite::Blackboard* pBlackboard) const
+{
+	// The behaviors of the options live in the arena of the decision maker
+	Elite::BehaviorArena* pArena{ new Elite::BehaviorArena{} };
+	Elite::BehaviorArena& arena{ *pArena };
+	Elite::BehaviorRoutinePool* pRoutinePool{ arena.Create<Elite::BehaviorRoutinePool>() };
+
+	Elite::UtilityDecisionMaker* pUtility{ new Elite::UtilityDecisionMaker{ pBlackboard, pArena } };
+
+	// The inputs of the decision maker, evaluated once per frame
+	const unsigned int enemyInFront{ pUtility->AddConsideration(UT_Considerations::EnemyInFront) };
+	const unsigned int nrEnemies{ pUtility->AddConsideration(UT_Considerations::NrEnemiesInFOV) };
+	const unsigned int hasGun{ pUtility->AddConsideration(UT_Considerations::HasGun) };
+	const unsigned int isAlerted{ pUtility->AddConsideration(UT_Considerations::IsAlerted) };
+	const unsigned int purgeZone{ pUtility->AddConsideration(UT_Considerations::PurgeZoneInFOV) };
+	const unsigned int lootInFov{ pUtility->AddConsideration(UT_Considerations::LootInFOV) };
+	const unsigned int lootInRange{ pUtility->AddConsideration(UT_Considerations::LootInGrabRange) };
+	const unsigned int insideHouse{ pUtility->AddConsideration(UT_Considerations::InsideHouse) };
+	const unsigned int towardsHouse{ pUtility->AddConsideration(UT_Considerations::MovingTowardsHouse) };
+	const unsigned int houseInFov{ pUtility->AddConsideration(UT_Considerations::HouseInFOV) };
+	const unsigned int itemNeed{ pUtility->AddConsideration(UT_Considerations::ItemNeed) };
+	const unsigned int energy{ pUtility->AddConsideration(UT_Considerations::Energy) };
+
+	// Shoot enemies in front of the agent
+	const unsigned int shoot
+	{
+		pUtility->AddOption("Shoot", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsEnemyInFront),
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsGunInInventory),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::Shoot)
+		}), 1.0f)
+	};
+	pUtility->SetResponse(shoot, enemyInFront, 1.0f, 0.0f);
+	pUtility->SetResponse(shoot, hasGun, 1.0f, 0.0f);
+
+	// Face enemies in fov, more enemies make this more urgent
+	const unsigned int faceEnemy
+	{
+		pUtility->AddOption("FaceEnemy", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsEnemyInFOV),
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsGunInInventory),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToFleeAndLookAt),
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsInsidePurgeZone),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToEntitySeek)
+		}), 0.95f)
+	};
+	pUtility->SetResponse(faceEnemy, nrEnemies, 0.25f, 0.75f);
+	pUtility->SetResponse(faceEnemy, hasGun, 1.0f, 0.0f);
+	pUtility->SetResponse(faceEnemy, enemyInFront, 0.0f, 1.0f);
+
+	// Look around after being bitten
+	const unsigned int lookForEnemy
 	{
-		new Elite::BehaviorTree
+		pUtility->AddOption("LookForEnemy", arena.CreateComposite<Elite::BehaviorSequence>(
 		{
-			pBlackboard,
-			new Elite::BehaviorSelector
+			arena.CreateComposite<Elite::BehaviorSelector>(
 			{
+				arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsLookingForEnemy),
+				arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsHitByEnemy)
+			}),
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsGunInInventory),
+			arena.CreateComposite<Elite::BehaviorInvertor>(
+			{
+				arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsInsidePurgeZone)
+			}),
+			arena.Create<Elite::BehaviorCoroutine>(pRoutinePool, BT_Routines::LookAround)
+		}), 0.9f)
+	};
+	pUtility->SetResponse(lookForEnemy, isAlerted, 1.0f, 0.0f);
+	pUtility->SetResponse(lookForEnemy, hasGun, 1.0f, 0.0f);
+
+	// Stay out of purge zones
+	const unsigned int avoidPurgeZone
+	{
+		pUtility->AddOption("AvoidPurgeZone", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsPurgeZoneInFront),
+			arena.CreateComposite<Elite::BehaviorSelector>(
+			{
+				arena.CreateComposite<Elite::BehaviorSequence>(
 				{
-					// Try to shoot enemies
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsEnemyInFront },
-							new Elite::BehaviorConditional{ BT_Conditions::IsGunInInventory },
-							new Elite::BehaviorAction{ BT_Actions::Shoot }
-						}
-					},
-					// Try to spot enemies
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsEnemyInFOV },
-							new Elite::BehaviorConditional{ BT_Conditions::IsGunInInventory },
-							new Elite::BehaviorAction{ BT_Actions::AddToFleeAndLookAt },
-							new Elite::BehaviorConditional{ BT_Conditions::IsInsidePurgeZone },
-							new Elite::BehaviorAction{ BT_Actions::AddToEntitySeek },
-						}
-					},
-					// Try to look at enemies
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorSelector
-							{
-								{
-									new Elite::BehaviorConditional{ BT_Conditions::IsLookingForEnemy },
-									new Elite::BehaviorConditional{ BT_Conditions::IsHitByEnemy }
-								}
-							},
-							new Elite::BehaviorConditional{ BT_Conditions::IsGunInInventory },
-							new Elite::BehaviorInvertor 
-							{
-								new Elite::BehaviorConditional{ BT_Conditions::IsInsidePurgeZone },
-							},
-							new Elite::BehaviorSelector
-							{
-								{
-									new Elite::BehaviorSequence
-									{
-										{
-											new Elite::BehaviorConditional{ BT_Conditions::IsPurgeZoneInFront },
-											new Elite::BehaviorAction{ BT_Actions::TurnToLookForEnemy }
-										}
-									},
-									new Elite::BehaviorAction{ BT_Actions::LookForEnemy }
-								}
-							}
-						}
-					},
-					// Try to avoid purge zones
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsPurgeZoneInFront },
-							new Elite::BehaviorSelector
-							{
-								{
-									new Elite::BehaviorSequence
-									{
-										{
-											new Elite::BehaviorConditional{ BT_Conditions::IsInsidePurgeZone },
-											new Elite::BehaviorAction{ BT_Actions::AddToEntitySeek },
-											new Elite::BehaviorAction{ BT_Actions::LookAtPurgeZone }
-										}
-									},
-									new Elite::BehaviorAction{ BT_Actions::StandStill }
-								}
-							}
-						}
-					},
-					// Try to pick up loot
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsLootInRange },
-							new Elite::BehaviorSelector
-							{
-								{
-									new Elite::BehaviorSequence
-									{
-										{
-											new Elite::BehaviorConditional{ BT_Conditions::IsInventoryNotFull },
-											new Elite::BehaviorAction{ BT_Actions::PickUpLoot }
-										}
-									},
-									new Elite::BehaviorSequence
-									{
-										{
-											new Elite::BehaviorConditional{ BT_Conditions::IsBetterInventoryPossible },
-											new Elite::BehaviorAction{ BT_Actions::PickUpLootAndRearrangeInventory }
-										}
-									},
-									new Elite::BehaviorAction{ BT_Actions::RememberCurrentLoot }
-								}
-							}
-							
-						}
-					},
-					// Try to spot loot
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsLootInFov },
-							new Elite::BehaviorInvertor
-							{
-								new Elite::BehaviorConditional{ BT_Conditions::IsLootAlreadySeen }
-							},
-							new Elite::BehaviorAction{ BT_Actions::AddToEntitySeek }
-						}
-					},
-					// Move around the building in search of loot
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsInsideHouse },
-							new Elite::BehaviorAction{ BT_Actions::SetTargetToCorner },
-							new Elite::BehaviorAction{ BT_Actions::AddToHouseSeek }
-						}
-					},
-					// Try moving to house
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsMovingTowardsHouse },
-							new Elite::BehaviorAction{ BT_Actions::AddToHouseSeek }
-						}
-					},
-					// Try to spot houses
-					new Elite::BehaviorSequence
-					{
-						{
-							new Elite::BehaviorConditional{ BT_Conditions::IsNewHouseInFOV },
-							new Elite::BehaviorSequence
-							{
-								{
-									new Elite::BehaviorAction{ BT_Actions::AddToHouseSeek },
-									new Elite::BehaviorAction{ BT_Actions::AddHouse }
-								}
-							}
-						}
-					},
-					// Fill inventory with known items
-					new Elite::BehaviorSequence
-					{
-						{
-							 new Elite::BehaviorConditional{ BT_Conditions::RemembersNeededItem },
-							 new Elite::BehaviorAction{ BT_Actions::AddToEntitySeek }
-						}
-					},
-					// Fall back to world exploration
-					new Elite::BehaviorAction{ BT_Actions::Explore },
-					new Elite::BehaviorAction{ BT_Actions::RevisitHouses }
-				}
-			}
-		}
+					arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsInsidePurgeZone),
+					arena.Create<Elite::BehaviorAction>(BT_Actions::AddToEntitySeek),
+					arena.Create<Elite::BehaviorAction>(BT_Actions::LookAtPurgeZone)
+				}),
+				arena.Create<Elite::BehaviorAction>(BT_Actions::StandStill)
+			})
+		}), 0.85f)
+	};
+	pUtility->SetResponse(avoidPurgeZone, purgeZone, 1.0f, 0.0f);
+
+	// Pick up loot in grab range
+	const unsigned int pickUpLoot
+	{
+		pUtility->AddOption("PickUpLoot", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsLootInRange),
+			arena.CreateComposite<Elite::BehaviorSelector>(
+			{
+				arena.CreateComposite<Elite::BehaviorSequence>(
+				{
+					arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsInventoryNotFull),
+					arena.Create<Elite::BehaviorAction>(BT_Actions::PickUpLoot)
+				}),
+				arena.CreateComposite<Elite::BehaviorSequence>(
+				{
+					arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsBetterInventoryPossible),
+					arena.Create<Elite::BehaviorAction>(BT_Actions::PickUpLootAndRearrangeInventory)
+				}),
+				arena.Create<Elite::BehaviorAction>(BT_Actions::RememberCurrentLoot)
+			})
+		}), 0.8f)
+	};
+	pUtility->SetResponse(pickUpLoot, lootInRange, 1.0f, 0.0f);
+
+	// Walk to loot in fov, more interesting when items are missing
+	const unsigned int seekLoot
+	{
+		pUtility->AddOption("SeekLoot", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsLootInFov),
+			arena.CreateComposite<Elite::BehaviorInvertor>(
+			{
+				arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsLootAlreadySeen)
+			}),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToEntitySeek)
+		}), 0.75f)
+	};
+	pUtility->SetResponse(seekLoot, lootInFov, 1.0f, 0.0f);
+	// Loot in grab range is picked up, walking to it is done
+	pUtility->SetResponse(seekLoot, lootInRange, -1.0f, 1.0f);
+	pUtility->SetResponse(seekLoot, itemNeed, 0.2f, 0.8f);
+
+	// Search the house the agent is in
+	const unsigned int sweepHouse
+	{
+		pUtility->AddOption("SweepHouse", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsInsideHouse),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::SetTargetToCorner),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToHouseSeek)
+		}), 0.6f)
+	};
+	pUtility->SetResponse(sweepHouse, insideHouse, 1.0f, 0.0f);
+
+	// Keep walking to the current house
+	const unsigned int goToHouse
+	{
+		pUtility->AddOption("GoToHouse", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsMovingTowardsHouse),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToHouseSeek)
+		}), 0.55f)
+	};
+	pUtility->SetResponse(goToHouse, towardsHouse, 1.0f, 0.0f);
+
+	// Start walking to a house in fov
+	const unsigned int newHouse
+	{
+		pUtility->AddOption("NewHouse", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::IsNewHouseInFOV),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToHouseSeek),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddHouse)
+		}), 0.5f)
 	};
+	pUtility->SetResponse(newHouse, houseInFov, 1.0f, 0.0f);
 
-	m_DecisionTree = pBehaviorTree;
+	// Go back to remembered items, low energy makes this more urgent
+	const unsigned int fetchItem
+	{
+		pUtility->AddOption("FetchItem", arena.CreateComposite<Elite::BehaviorSequence>(
+		{
+			arena.Create<Elite::BehaviorConditional>(BT_Conditions::RemembersNeededItem),
+			arena.Create<Elite::BehaviorAction>(BT_Actions::AddToEntitySeek)
+		}), 0.5f)
+	};
+	pUtility->SetResponse(fetchItem, itemNeed, 4.0f, 0.0f);
+	pUtility->SetResponse(fetchItem, energy, -0.5f, 1.0f);
+
+	// Fall back to world exploration
+	pUtility->AddOption("Explore", arena.Create<Elite::BehaviorAction>(BT_Actions::Explore), 0.2f);
+	pUtility->AddOption("RevisitHouses", arena.Create<Elite::BehaviorAction>(BT_Actions::RevisitHouses), 0.1f);
+
+	return pUtility;
+}
+
+Elite::GOAPDecisionMaker* Plugin::CreateGOAPDecisionMaking(Elite::Blackboard* pBlackboard) const
+{
+	// The behaviors of the actions live in the arena of the decision maker
+	Elite::BehaviorArena* pArena{ new Elite::BehaviorArena{} };
+	Elite::BehaviorArena& arena{ *pArena };
+
+	Elite::GOAPDecisionMaker* pGOAP{ new Elite::GOAPDecisionMaker{ pBlackboard, pArena } };
+
+	// Enemies and purge zones can not wait for a plan
+	pGOAP->SetReactiveBehavior(CreateCombatBehavior(arena));
+	// Without a plan, keep searching the world for loot
+	pGOAP->SetFallbackBehavior(CreateSearchBehavior(arena));
+
+	// The facts of the world state
+	const Elite::GOAPWorldState energyLow{ pGOAP->AddFact(GOAP_Facts::IsEnergyLow) };
+	const Elite::GOAPWorldState healthLow{ pGOAP->AddFact(GOAP_Facts::IsHealthLow) };
+	const Elite::GOAPWorldState inventoryFull{ pGOAP->AddFact(GOAP_Facts::IsInventoryFull) };
+
+	// Every item type can be fetched the same way: walk to a remembered item and pick it up
+	constexpr int nrItemTypes{ 3 };
+	const eItemType itemTypes[nrItemTypes]{ eItemType::FOOD, eItemType::MEDKIT, eItemType::PISTOL };
+	const std::string itemNames[nrItemTypes]{ "Food", "Medkit", "Gun" };
+	Elite::GOAPWorldState hasItem[nrItemTypes]{};
+
+	for (int i{}; i < nrItemTypes; ++i)
+	{
+		const eItemType itemType{ itemTypes[i] };
+
+		hasItem[i] = pGOAP->AddFact([itemType](Elite::Blackboard* pBlackboard) { return GOAP_Facts::HasItem(pBlackboard, itemType); });
+		const Elite::GOAPWorldState remembersItem{ pGOAP->AddFact([itemType](Elite::Blackboard* pBlackboard) { return GOAP_Facts::RemembersItem(pBlackboard, itemType); }) };
+		const Elite::GOAPWorldState isAtItem{ pGOAP->AddFact([itemType](Elite::Blackboard* pBlackboard) { return GOAP_Facts::IsAtItem(pBlackboard, itemType); }) };
+
+		pGOAP->AddAction(
+		{
+			"GoTo" + itemNames[i],
+			remembersItem | isAtItem, remembersItem,
+			isAtItem, isAtItem,
+			4.0f,
+			arena.Create<Elite::BehaviorAction>([itemType](Elite::Blackboard* pBlackboard) { return GOAP_Actions::GoToRememberedItem(pBlackboard, itemType); })
+		});
+		pGOAP->AddAction(
+		{
+			"PickUp" + itemNames[i],
+			isAtItem | inventoryFull, isAtItem,
+			isAtItem | hasItem[i], hasItem[i],
+			1.0f,
+			arena.Create<Elite::BehaviorAction>([itemType](Elite::Blackboard* pBlackboard) { return GOAP_Actions::PickUpRememberedItem(pBlackboard, itemType); })
+		});
+	}
+
+	// Use the items
+	pGOAP->AddAction(
+	{
+		"Eat",
+		hasItem[0], hasItem[0],
+		hasItem[0] | energyLow, 0,
+		1.0f,
+		arena.Create<Elite::BehaviorAction>([](Elite::Blackboard* pBlackboard) { return GOAP_Actions::UseItem(pBlackboard, eItemType::FOOD); })
+	});
+	pGOAP->AddAction(
+	{
+		"Heal",
+		hasItem[1], hasItem[1],
+		hasItem[1] | healthLow, 0,
+		1.0f,
+		arena.Create<Elite::BehaviorAction>([](Elite::Blackboard* pBlackboard) { return GOAP_Actions::UseItem(pBlackboard, eItemType::MEDKIT); })
+	});
+
+	// Survival goals go before stocking up on items
+	pGOAP->AddGoal({ "Heal", healthLow, 0, [](Elite::Blackboard*) { return 1.0f; } });
+	pGOAP->AddGoal({ "Eat", energyLow, 0, [](Elite::Blackboard*) { return 0.9f; } });
+	pGOAP->AddGoal({ "StockGun", hasItem[2], hasItem[2], [](Elite::Blackboard*) { return 0.7f; } });
+	pGOAP->AddGoal({ "StockFood", hasItem[0], hasItem[0], [](Elite::Blackboard*) { return 0.6f; } });
+	pGOAP->AddGoal({ "StockMedkit", hasItem[1], hasItem[1], [](Elite::Blackboard*) { return 0.5f; } });
+
+	return pGOAP;
+}
+
+Elite::IBehavior* Plugin::CreateDefaultBehavior(Elite::BehaviorArena& arena) const
+{
+	// The built-in trees are fixed, so they are compiled into direct calls
+	return arena.Create<Elite::StaticBehavior<BT_Trees::Default>>();
+}
+
+Elite::IBehavior* Plugin::CreateCombatBehavior(Elite::BehaviorArena& arena) const
+{
+	return arena.Create<Elite::StaticBehavior<BT_Trees::Combat>>();
+}
+
+Elite::IBehavior* Plugin::CreateSearchBehavior(Elite::BehaviorArena& arena) const
+{
+	return arena.Create<Elite::StaticBehavior<BT_Trees::Search>>();
 }
 
 //Called only once
@@ -226,7 +413,7 @@ void Plugin::DllInit()
 void Plugin::DllShutdown()
 {
 	//Called wheb the plugin gets unloaded
-	delete m_pExplorer;
+	Release();
 }
 
 //Called only once, during initialization
@@ -318,24 +505,49 @@ void Plugin::Update(float dt)
 //This function calculates the new SteeringOutput, called once per frame
 SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 {	
+	// Everything that was allocated for the last frame is free again
+	m_pFrameArena->Reset();
+
 	// Store the current FOV data
-	m_HousesInFOV = GetHousesInFOV();
-	m_EntitiesInFOV = GetEntitiesInFOV();
+	GetHousesInFOV(m_HousesInFOV);
+	GetEntitiesInFOV(m_EntitiesInFOV);
 
 	//Use the Interface (IAssignmentInterface) to 'interface' with the AI_Framework
-	const AgentInfo agentInfo = m_pInterface->Agent_GetInfo();
+	m_AgentInfo = m_pInterface->Agent_GetInfo();
+	const AgentInfo& agentInfo = m_AgentInfo;
+
+	// Order the entities in fov once, every behavior reads the same views
+	m_pPerception->Update(m_EntitiesInFOV, agentInfo.Position, *m_pHouses);
+
+	// Remembered items that are seen again are kept longer when the memory is full
+	m_pItemMemory->Update(*m_pPerception);
+
+	// Remember the enemies, also the ones that left the fov
+	m_pEnemyTracker->Update(m_pInterface, *m_pPerception, agentInfo, dt);
+
+	// Known threats make the directions towards them less interesting to steer to
+	AddSteeringDangers();
+
+	// The house sweeps are planned for the current fov
+	m_pSweepPlanner->SetFov(agentInfo.FOV_Range, agentInfo.FOV_Angle);
 
 	// Update the World Explorer
-	m_pExplorer->Update(agentInfo.Position, agentInfo.Orientation);
+	m_pExplorer->Update(agentInfo);
 
-	// Update the Inventory
-	m_pInventoryManager->Update(agentInfo.Health, agentInfo.Energy);
+	// Update the Inventory, the GOAP planner decides itself when to eat and heal
+	if (m_DecisionMakingType != DecisionMakingType::GOAP) m_pInventoryManager->Update(agentInfo.Health, agentInfo.Energy);
+
+	// Reload the behavior tree when its file changed
+	if (m_DecisionTree) ReloadBehaviorTree(dt);
 
 	// Update the decision making
-	m_DecisionTree->Update(dt);
+	m_pDecisionMaking->Update(dt);
+
+	// Continue the sliced tasks, their results are used in the next frames
+	m_pScheduler->Update();
 
 	// Retrieve the steering output from the decision tree
-	auto steering = m_pSteering->Update(agentInfo);
+	auto steering = m_pSteering->Update(agentInfo, dt);
 
 	//INVENTORY USAGE DEMO
 	//********************
@@ -363,51 +575,122 @@ SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 //This function should only be used for rendering debug elements
 void Plugin::Render(float dt) const
 {
+	// Render only runs after UpdateSteering is done with the arena
+	m_pFrameArena->Reset();
+
 	//This Render function should only contain calls to Interface->Draw_... functions
 	m_pInterface->Draw_SolidCircle(m_Target, .7f, { 0,0 }, { 1, 0, 0 });
 
-	m_pExplorer->DrawDebug(m_pInterface);
+	m_pExplorer->DrawDebug(m_pInterface, *m_pFrameArena);
+	m_pLootTour->DrawDebug(m_pInterface, m_AgentInfo.Position);
 
-	for (const EntityInfo& entity : m_Entities)
+	for (const FoundEntityInfo& entity : m_pItemMemory->GetItems())
 	{
 		m_pInterface->Draw_SolidCircle(entity.Location, 1.0f, { 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 0);
 	}
 }
 
-vector<HouseInfo> Plugin::GetHousesInFOV() const
+void Plugin::ReloadBehaviorTree(float dt)
 {
-	vector<HouseInfo> vHousesInFOV = {};
+	// Only look at the file every so often
+	constexpr float reloadCheckInterval{ 1.0f };
+	m_ReloadTimer += dt;
+	if (m_ReloadTimer < reloadCheckInterval) return;
+	m_ReloadTimer = 0.0f;
+
+	if (!m_pTreeLoader->HasFileChanged()) return;
+
+	// Build the new tree next to the current one
+	Elite::BehaviorArena* pArena{ new Elite::BehaviorArena{} };
+	Elite::IBehavior* pRootBehavior{ m_pTreeLoader->Load(*pArena) };
+
+	// If the new tree is invalid, keep running the current tree
+	if (!pRootBehavior)
+	{
+		std::cout << "Keeping the current behavior tree\n";
+		delete pArena;
+		return;
+	}
+
+	std::cout << "Reloaded " << m_pTreeLoader->GetFilePath() << "\n";
+	m_DecisionTree->SetRootBehavior(pArena, pRootBehavior);
+}
+
+void Plugin::Release()
+{
+	// The decision making owns the blackboard and every node of the tree
+	SAFE_DELETE(m_pDecisionMaking);
+	m_DecisionTree = nullptr;
+	SAFE_DELETE(m_pTreeLoader);
+	SAFE_DELETE(m_pSteering);
+	SAFE_DELETE(m_pScheduler);
+	SAFE_DELETE(m_pPerception);
+	SAFE_DELETE(m_pSweepPlanner);
+	SAFE_DELETE(m_pLootTour);
+	SAFE_DELETE(m_pEnemyPredictor);
+	SAFE_DELETE(m_pPathCache);
+	SAFE_DELETE(m_pFrameArena);
+	SAFE_DELETE(m_pEnemyTracker);
+	SAFE_DELETE(m_pInventoryManager);
+	SAFE_DELETE(m_pExplorer);
+	SAFE_DELETE(m_pHouses);
+	SAFE_DELETE(m_pItemMemory);
+}
+
+void Plugin::AddSteeringDangers() const
+{
+	constexpr float enemyDangerRadius{ 12.0f };
+	for (UINT i{}; i < m_pEnemyTracker->GetNrEnemies(); ++i)
+	{
+		m_pSteering->AddDanger(m_pEnemyTracker->GetPredictedPosition(i), enemyDangerRadius, m_AgentInfo);
+	}
+
+	// Enemies this close are also worth spending the stamina reserve on
+	m_pSteering->SetNrNearbyThreats(m_pEnemyTracker->GetNrThreatsInRadius(m_AgentInfo.Position, enemyDangerRadius));
+
+	// The danger of a purge zone reaches a bit further than its edge
+	constexpr float purgeZoneMargin{ 5.0f };
+	for (UINT index : m_pPerception->GetPurgeZones())
+	{
+		PurgeZoneInfo zoneInfo{};
+		if (!m_pInterface->PurgeZone_GetInfo(m_pPerception->GetEntity(index), zoneInfo)) continue;
+
+		m_pSteering->AddDanger(zoneInfo.Center, zoneInfo.Radius + purgeZoneMargin, m_AgentInfo);
+	}
+}
+
+void Plugin::GetHousesInFOV(vector<HouseInfo>& housesInFOV) const
+{
+	// Refill the vector in place, so its memory is reused every frame
+	housesInFOV.clear();
 
 	HouseInfo hi = {};
 	for (int i = 0;; ++i)
 	{
 		if (m_pInterface->Fov_GetHouseByIndex(i, hi))
 		{
-			vHousesInFOV.push_back(hi);
+			housesInFOV.push_back(hi);
 			continue;
 		}
 
 		break;
 	}
-
-	return vHousesInFOV;
 }
 
-vector<EntityInfo> Plugin::GetEntitiesInFOV() const
+void Plugin::GetEntitiesInFOV(vector<EntityInfo>& entitiesInFOV) const
 {
-	vector<EntityInfo> vEntitiesInFOV = {};
+	// Refill the vector in place, so its memory is reused every frame
+	entitiesInFOV.clear();
 
 	EntityInfo ei = {};
 	for (int i = 0;; ++i)
 	{
 		if (m_pInterface->Fov_GetEntityByIndex(i, ei))
 		{
-			vEntitiesInFOV.push_back(ei);
+			entitiesInFOV.push_back(ei);
 			continue;
 		}
 
 		break;
 	}
-
-	return vEntitiesInFOV;
 }
@@ -3,17 +3,38 @@
 #include "Exam_HelperStructs.h"
 #include "ExtendedStructs.h"
 #include "EBehaviorTree.h"
+#include "EUtilityAI.h"
+#include "EGOAP.h"
 
 class IBaseInterface;
 class IExamInterface;
 class WorldExplorer;
 class InventoryManager;
 class Steering;
+class BehaviorTreeLoader;
+class TaskScheduler;
+class Perception;
+class HouseRegistry;
+class SweepPlanner;
+class LootTourPlanner;
+class EnemyTracker;
+class EnemyPredictor;
+class PathCache;
+class FrameArena;
+class ItemMemory;
+
+enum class DecisionMakingType
+{
+	BehaviorTree,
+	Utility,
+	GOAP
+};
 
 class Plugin : public IExamPlugin
 {
 public:
-	Plugin() {};
+	// The host picks the decision making, Register uses the behavior tree
+	explicit Plugin(DecisionMakingType decisionMakingType = DecisionMakingType::BehaviorTree) : m_DecisionMakingType{ decisionMakingType } {};
 	virtual ~Plugin() {};
 
 	void Initialize(IBaseInterface* pInterface, PluginInfo& info) override;
@@ -32,12 +53,21 @@ private:
 	WorldExplorer* m_pExplorer{};
 	InventoryManager* m_pInventoryManager{};
 	Steering* m_pSteering{};
+	TaskScheduler* m_pScheduler{};
+	Perception* m_pPerception{};
+	HouseRegistry* m_pHouses{};
+	SweepPlanner* m_pSweepPlanner{};
+	LootTourPlanner* m_pLootTour{};
+	EnemyTracker* m_pEnemyTracker{};
+	EnemyPredictor* m_pEnemyPredictor{};
+	PathCache* m_pPathCache{};
+	// Per frame temporaries, reset at the start of UpdateSteering and Render
+	FrameArena* m_pFrameArena{};
+	ItemMemory* m_pItemMemory{};
 
-	std::vector<HouseInfo> m_Houses{};
 	std::vector<HouseInfo> m_HousesInFOV{};
 
 	std::vector<EntityInfo> m_EntitiesInFOV{};
-	std::vector<FoundEntityInfo> m_Entities{};
 
 	Elite::Vector2 m_Target = {};
 	bool m_CanRun = false; //Demo purpose
@@ -48,19 +78,32 @@ private:
 
 	UINT m_InventorySlot = 0;
 
-	Elite::BehaviorTree* m_DecisionTree{};
+	DecisionMakingType m_DecisionMakingType{};
+	Elite::IDecisionMaking* m_pDecisionMaking{};
+	Elite::BehaviorTree* m_DecisionTree{}; // Only set when the decision making is a behavior tree
+	BehaviorTreeLoader* m_pTreeLoader{};
+	float m_ReloadTimer{};
+
+	AgentInfo m_AgentInfo{};
 
-	std::vector<HouseInfo> GetHousesInFOV() const;
-	std::vector<EntityInfo> GetEntitiesInFOV() const;
+	Elite::BehaviorTree* CreateBehaviorTree(Elite::Blackboard* pBlackboard);
+	Elite::UtilityDecisionMaker* CreateUtilityDecisionMaking(Elite::Blackboard* pBlackboard) const;
+	Elite::GOAPDecisionMaker* CreateGOAPDecisionMaking(Elite::Blackboard* pBlackboard) const;
+	Elite::IBehavior* CreateDefaultBehavior(Elite::BehaviorArena& arena) const;
+	Elite::IBehavior* CreateCombatBehavior(Elite::BehaviorArena& arena) const;
+	Elite::IBehavior* CreateSearchBehavior(Elite::BehaviorArena& arena) const;
+	void ReloadBehaviorTree(float dt);
+	void Release();
+	void AddSteeringDangers() const;
+	void GetHousesInFOV(std::vector<HouseInfo>& housesInFOV) const;
+	void GetEntitiesInFOV(std::vector<EntityInfo>& entitiesInFOV) const;
 };
 
 //ENTRY
 //This is the first function that is called by the host program
 //The plugin returned by this function is also the plugin used by the host program
+//Defined in Plugin.cpp, so other hosts like the benchmark can include this header
 extern "C"
 {
-	__declspec (dllexport) IPluginBase* Register()
-	{
-		return new Plugin();
-	}
+	__declspec (dllexport) IPluginBase* Register();
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "stdafx.h"
+#include "StaminaScheduler.h"
+
+void StaminaScheduler::Observe(const AgentInfo& agent, float deltaTime)
+{
+	if (m_PreviousStamina >= 0.0f && deltaTime > FLT_EPSILON)
+	{
+		const float staminaChange{ agent.Stamina - m_PreviousStamina };
+
+		// Only frames where the stamina actually changed say something about the rates
+		if (m_WasRunning && staminaChange < 0.0f) m_DrainRate += (-staminaChange / deltaTime - m_DrainRate) * m_Smoothing;
+		else if (!m_WasRunning && staminaChange > 0.0f) m_RegenRate += (staminaChange / deltaTime - m_RegenRate) * m_Smoothing;
+	}
+
+	if (agent.RunMode && agent.CurrentLinearSpeed > m_RunSpeed) m_RunSpeed = agent.CurrentLinearSpeed;
+	if (!agent.RunMode && agent.CurrentLinearSpeed > m_WalkSpeed) m_WalkSpeed = agent.CurrentLinearSpeed;
+	m_MaxStamina = std::max(m_MaxStamina, agent.Stamina);
+
+	m_PreviousStamina = agent.Stamina;
+	m_WasRunning = agent.RunMode;
+}
+
+bool StaminaScheduler::ShouldRun(const AgentInfo& agent, float remainingDistance, int nrNearbyThreats)
+{
+	// Close threats may use the reserve
+	const bool isThreatened{ nrNearbyThreats > 0 };
+	const float usableStamina{ agent.Stamina - (isThreatened ? 0.0f : m_ThreatReserve) };
+	if (usableStamina <= 0.0f)
+	{
+		m_IsRunWindowOpen = false;
+		return false;
+	}
+
+	if (isThreatened) return true;
+
+	// If the rest of the way can be run with the usable stamina, run it
+	const float runSpeed{ std::max(m_RunSpeed, agent.MaxLinearSpeed) };
+	const float runDistance{ usableStamina / m_DrainRate * runSpeed };
+	if (remainingDistance <= runDistance) return true;
+
+	// Otherwise walk and run the last stretch, with full stamina that stretch is this long
+	const float walkSpeed{ m_WalkSpeed > FLT_EPSILON ? m_WalkSpeed : agent.MaxLinearSpeed };
+	const float lastRunDistance{ (m_MaxStamina - m_ThreatReserve) / m_DrainRate * runSpeed };
+	const float walkTime{ std::max(0.0f, remainingDistance - lastRunDistance) / walkSpeed };
+
+	// Regeneration past the maximum is wasted, the stamina walking would regenerate above it can be spent now
+	const float surplus{ walkTime * m_RegenRate - (m_MaxStamina - agent.Stamina) };
+	const bool isFull{ agent.Stamina >= m_MaxStamina - m_FullMargin };
+	if (surplus >= m_MinWindowSurplus || isFull) m_IsRunWindowOpen = true;
+
+	return m_IsRunWindowOpen;
+}
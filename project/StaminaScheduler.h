@@ -0,0 +1,33 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+
+// Decides when the agent runs, from how fast stamina drains and regenerates
+// The rates are learned from the agent info of every frame instead of being hardcoded
+class StaminaScheduler final
+{
+public:
+	void Observe(const AgentInfo& agent, float deltaTime);
+
+	// Should the agent run this frame to reach a target this far away?
+	bool ShouldRun(const AgentInfo& agent, float remainingDistance, int nrNearbyThreats);
+private:
+	// Stamina per second, refined by every observed frame
+	float m_DrainRate{ 1.0f };
+	float m_RegenRate{ 0.5f };
+	float m_RunSpeed{};
+	float m_WalkSpeed{};
+	float m_MaxStamina{ 10.0f };
+
+	float m_PreviousStamina{ -1.0f };
+	bool m_WasRunning{};
+	// A run window lasts until the stamina above the reserve is used up
+	bool m_IsRunWindowOpen{};
+
+	constexpr static float m_Smoothing{ 0.1f };
+	// Stamina this close to the maximum counts as full
+	constexpr static float m_FullMargin{ 0.1f };
+	// Surplus stamina a run window needs to open, so it is not spent in runs of a few frames
+	constexpr static float m_MinWindowSurplus{ 1.0f };
+	// Stamina that is only spent when a threat is close, so the agent can always get away
+	constexpr static float m_ThreatReserve{ 2.0f };
+};
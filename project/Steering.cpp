@@ -1,16 +1,61 @@
 #include "stdafx.h"
 #include "Steering.h"
 
+Steering::Steering()
+{
+    // Spread the slots evenly around the agent
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        const float angle{ static_cast<float>(E_PI) * 2.0f * i / m_NrSlots };
+        m_SlotDirections[i] = Elite::Vector2{ cosf(angle), sinf(angle) };
+    }
+}
+
+void Steering::SetMode(Mode mode)
+{
+    m_Mode = mode;
+}
+
 void Steering::AddSeek(const Elite::Vector2& target, const AgentInfo& agent)
 {
-    const Elite::Vector2 dir{ target - agent.Position };
-    m_SeekDir += dir.GetNormalized();
+    const Elite::Vector2 dir{ (target - agent.Position).GetNormalized() };
+    m_SeekDir += dir;
+
+    // Every direction that brings the agent closer is interesting
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        m_Interest[i] = std::max(m_Interest[i], m_SlotDirections[i].Dot(dir));
+    }
+    m_HasInterest = true;
 }
 
 void Steering::AddFlee(const Elite::Vector2& target, const AgentInfo& agent)
 {
-    const Elite::Vector2 dir{ agent.Position - target };
-    m_FleeDir += dir.GetNormalized();
+    const Elite::Vector2 dir{ (agent.Position - target).GetNormalized() };
+    m_FleeDir += dir;
+
+    // Moving away is interesting, moving towards the target is dangerous
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        const float dot{ m_SlotDirections[i].Dot(dir) };
+        m_Interest[i] = std::max(m_Interest[i], dot);
+        m_Danger[i] = std::max(m_Danger[i], -dot);
+    }
+    m_HasInterest = true;
+}
+
+void Steering::AddDanger(const Elite::Vector2& position, float radius, const AgentInfo& agent)
+{
+    Elite::Vector2 dir{ position - agent.Position };
+    const float distance{ dir.Normalize() };
+    if (distance >= radius) return;
+
+    // The closer the danger, the stronger it blocks its direction
+    const float weight{ 1.0f - distance / radius };
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        m_Danger[i] = std::max(m_Danger[i], m_SlotDirections[i].Dot(dir) * weight);
+    }
 }
 
 void Steering::LookAt(const Elite::Vector2& target)
@@ -29,6 +74,18 @@ void Steering::Run()
     m_IsRunning = true;
 }
 
+void Steering::RunTowards(const Elite::Vector2& target, const AgentInfo& agent)
+{
+    // The closest target decides
+    m_HasRunTarget = true;
+    m_RunDistance = std::min(m_RunDistance, target.Distance(agent.Position));
+}
+
+void Steering::SetNrNearbyThreats(int nrThreats)
+{
+    m_NrNearbyThreats = nrThreats;
+}
+
 void Steering::Reset()
 {
     m_SeekDir.x = 0.0f;
@@ -37,17 +94,36 @@ void Steering::Reset()
     m_FleeDir.y = 0.0f;
     m_IsLookingAt = false;
     m_IsRunning = false;
+    m_HasRunTarget = false;
+    m_RunDistance = FLT_MAX;
+    m_NrNearbyThreats = 0;
     m_AngularVelocity = 0.0f;
+
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        m_Interest[i] = 0.0f;
+        m_Danger[i] = 0.0f;
+    }
+    m_HasInterest = false;
 }
 
-SteeringPlugin_Output Steering::Update(const AgentInfo& agent)
+SteeringPlugin_Output Steering::Update(const AgentInfo& agent, float deltaTime)
 {
     SteeringPlugin_Output steering{};
 
-    // Calculate the combined flee and seek
-    steering.LinearVelocity += m_FleeDir + m_SeekDir;
-    steering.LinearVelocity.Normalize();
-    steering.LinearVelocity *= agent.MaxLinearSpeed;
+    // Learn how fast the stamina changes
+    m_StaminaScheduler.Observe(agent, deltaTime);
+
+    if (m_Mode == Mode::Context) // Pick the best direction from the context maps
+    {
+        steering.LinearVelocity = GetContextDirection() * agent.MaxLinearSpeed;
+    }
+    else // Calculate the combined flee and seek
+    {
+        steering.LinearVelocity += m_FleeDir + m_SeekDir;
+        steering.LinearVelocity.Normalize();
+        steering.LinearVelocity *= agent.MaxLinearSpeed;
+    }
 
     if (m_IsLookingAt) // If lookat is enabled
     {
@@ -71,8 +147,8 @@ SteeringPlugin_Output Steering::Update(const AgentInfo& agent)
         steering.AngularVelocity = m_AngularVelocity;
     }
 
-    // Apply the run mode
-    steering.RunMode = m_IsRunning;
+    // Apply the run mode, a run target only runs when the stamina scheduler allows it
+    steering.RunMode = m_IsRunning || (m_HasRunTarget && m_StaminaScheduler.ShouldRun(agent, m_RunDistance, m_NrNearbyThreats));
 
     // Reset the member variables for the next frame
     Reset();
@@ -80,3 +156,42 @@ SteeringPlugin_Output Steering::Update(const AgentInfo& agent)
     // Return the calculated steering
     return steering;
 }
+
+Elite::Vector2 Steering::GetContextDirection()
+{
+    // Without a target the agent stands still
+    if (!m_HasInterest)
+    {
+        m_PreviousDirection = Elite::Vector2{};
+        return m_PreviousDirection;
+    }
+
+    // Find the direction with the most interest that is left after the danger
+    int bestSlot{};
+    float bestValue{ -FLT_MAX };
+    for (int i{}; i < m_NrSlots; ++i)
+    {
+        const float value{ m_Interest[i] - m_Danger[i] };
+        if (value > bestValue)
+        {
+            bestValue = value;
+            bestSlot = i;
+        }
+    }
+
+    // Fit a parabola through the best slot and its neighbours, so the direction is not limited to the slots
+    const float previous{ m_Interest[(bestSlot + m_NrSlots - 1) % m_NrSlots] - m_Danger[(bestSlot + m_NrSlots - 1) % m_NrSlots] };
+    const float next{ m_Interest[(bestSlot + 1) % m_NrSlots] - m_Danger[(bestSlot + 1) % m_NrSlots] };
+    const float curvature{ previous - 2.0f * bestValue + next };
+    const float offset{ curvature < -FLT_EPSILON ? Elite::Clamp(0.5f * (previous - next) / curvature, -0.5f, 0.5f) : 0.0f };
+
+    const float angle{ static_cast<float>(E_PI) * 2.0f * (bestSlot + offset) / m_NrSlots };
+    Elite::Vector2 direction{ cosf(angle), sinf(angle) };
+
+    // Blend with the previous direction, so the agent does not flip between two directions
+    direction = direction * (1.0f - m_DirectionSmoothing) + m_PreviousDirection * m_DirectionSmoothing;
+    if (direction.Normalize() < FLT_EPSILON) direction = Elite::Vector2{ cosf(angle), sinf(angle) };
+
+    m_PreviousDirection = direction;
+    return direction;
+}
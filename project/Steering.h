@@ -1,22 +1,59 @@
 #pragma once
 #include <Exam_HelperStructs.h>
+#include "StaminaScheduler.h"
 class Steering final
 {
 public:
+	// Blend sums the seek and flee directions
+	// Context fills an interest and a danger value for every direction around the agent and picks the best direction
+	enum class Mode
+	{
+		Blend,
+		Context
+	};
+
+	Steering();
+
+	void SetMode(Mode mode);
+
 	void AddSeek(const Elite::Vector2& target, const AgentInfo& agent);
 	void AddFlee(const Elite::Vector2& target, const AgentInfo& agent);
+	// Makes the directions towards the position less interesting, the closer the agent is the stronger (context mode only)
+	void AddDanger(const Elite::Vector2& position, float radius, const AgentInfo& agent);
 	void LookAt(const Elite::Vector2& target);
 	void Rotate(float velocity);
 	void Run();
+	// Lets the stamina scheduler decide whether running to the target is worth it
+	void RunTowards(const Elite::Vector2& target, const AgentInfo& agent);
+	void SetNrNearbyThreats(int nrThreats);
 	void Reset();
 
-	SteeringPlugin_Output Update(const AgentInfo& agent);
+	SteeringPlugin_Output Update(const AgentInfo& agent, float deltaTime);
 private:
+	Elite::Vector2 GetContextDirection();
+
+	Mode m_Mode{ Mode::Blend };
+
 	Elite::Vector2 m_SeekDir{};
 	Elite::Vector2 m_FleeDir{};
 	bool m_IsLookingAt{};
 	Elite::Vector2 m_LookAtTarget{};
 	float m_AngularVelocity{};
 	bool m_IsRunning{};
-};
 
+	StaminaScheduler m_StaminaScheduler{};
+	bool m_HasRunTarget{};
+	float m_RunDistance{ FLT_MAX };
+	int m_NrNearbyThreats{};
+
+	// Context maps, one slot per direction around the agent
+	constexpr static int m_NrSlots{ 32 };
+	Elite::Vector2 m_SlotDirections[m_NrSlots]{};
+	float m_Interest[m_NrSlots]{};
+	float m_Danger[m_NrSlots]{};
+	bool m_HasInterest{};
+	Elite::Vector2 m_PreviousDirection{};
+
+	// How much of the previous direction is kept, so the agent does not flip between two directions
+	constexpr static float m_DirectionSmoothing{ 0.5f };
+};
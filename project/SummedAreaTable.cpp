@@ -0,0 +1,32 @@
+#include "stdafx.h"
+#include "SummedAreaTable.h"
+#include "BitGrid.h"
+
+void SummedAreaTable::Build(const BitGrid& grid)
+{
+	m_Size = grid.GetSize() + 1;
+	m_Sums.assign(static_cast<size_t>(m_Size) * m_Size, 0);
+
+	for (int y{ 1 }; y < m_Size; ++y)
+	{
+		// The sum of a row so far, added to the sums of the row below
+		int rowSum{};
+		for (int x{ 1 }; x < m_Size; ++x)
+		{
+			rowSum += grid.Get(x - 1, y - 1);
+			m_Sums[y * m_Size + x] = m_Sums[(y - 1) * m_Size + x] + rowSum;
+		}
+	}
+}
+
+int SummedAreaTable::GetCount(int minX, int minY, int maxX, int maxY) const
+{
+	// Move to table space, where the rectangle ends one past max
+	minX = std::max(minX, 0);
+	minY = std::max(minY, 0);
+	maxX = std::min(maxX + 1, m_Size - 1);
+	maxY = std::min(maxY + 1, m_Size - 1);
+	if (minX >= maxX || minY >= maxY) return 0;
+
+	return m_Sums[maxY * m_Size + maxX] - m_Sums[minY * m_Size + maxX] - m_Sums[maxY * m_Size + minX] + m_Sums[minY * m_Size + minX];
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <vector>
+
+class BitGrid;
+
+// Counts the set cells of a bit grid in any rectangle with four lookups
+// Every entry holds the number of set cells below and left of it, the table is built again when the grid changed
+class SummedAreaTable final
+{
+public:
+	void Build(const BitGrid& grid);
+
+	// The number of set cells from min up to and including max, the rectangle is clamped to the grid
+	int GetCount(int minX, int minY, int maxX, int maxY) const;
+private:
+	// One row and column more than the grid, so the first row and column are always zero
+	int m_Size{};
+	std::vector<int> m_Sums{};
+};
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+#include "SweepPlanner.h"
+
+void SweepPlanner::SetFov(float fovRange, float fovAngle)
+{
+	if (abs(fovRange - m_FovRange) < FLT_EPSILON && abs(fovAngle - m_FovAngle) < FLT_EPSILON) return;
+
+	m_FovRange = fovRange;
+	m_FovAngle = fovAngle;
+	m_Tours.clear();
+}
+
+const std::vector<Elite::Vector2>& SweepPlanner::GetTour(const Elite::Vector2& houseSize)
+{
+	const long long key{ GetKey(houseSize) };
+
+	// Plan the tour the first time a house of this size is looted
+	const auto it{ m_Tours.find(key) };
+	if (it != m_Tours.end()) return it->second;
+
+	return m_Tours[key] = PlanTour(houseSize);
+}
+
+Elite::Vector2 SweepPlanner::GetTourDirection(const Elite::Vector2& houseCenter, const Elite::Vector2& houseSize, const Elite::Vector2& agentPosition)
+{
+	const std::vector<Elite::Vector2>& tour{ GetTour(houseSize) };
+
+	Elite::Vector2 bestDirection{ 1.0f, 1.0f };
+	if (tour.empty()) return bestDirection;
+
+	// Mirroring the tour lets it start in any corner of the house
+	float closestDistance{ FLT_MAX };
+	for (const Elite::Vector2& direction : { Elite::Vector2{ 1.0f, 1.0f }, Elite::Vector2{ -1.0f, 1.0f }, Elite::Vector2{ 1.0f, -1.0f }, Elite::Vector2{ -1.0f, -1.0f } })
+	{
+		const Elite::Vector2 start{ houseCenter.x + tour[0].x * direction.x, houseCenter.y + tour[0].y * direction.y };
+
+		const float distance{ start.DistanceSquared(agentPosition) };
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			bestDirection = direction;
+		}
+	}
+
+	return bestDirection;
+}
+
+std::vector<Elite::Vector2> SweepPlanner::PlanTour(const Elite::Vector2& houseSize) const
+{
+	// The part of the house the agent can walk in
+	const float width{ std::max(0.0f, houseSize.x - 2.0f * (m_WallThickness + m_WallMargin)) };
+	const float height{ std::max(0.0f, houseSize.y - 2.0f * (m_WallThickness + m_WallMargin)) };
+
+	// Walk the lanes along the longest side, so the agent turns as little as possible
+	const bool isHorizontal{ width >= height };
+	const float laneLength{ isHorizontal ? width : height };
+	const float sweepLength{ isHorizontal ? height : width };
+
+	// While walking, the fov sees this far to each side
+	const float laneWidth{ std::max(1.0f, m_FovRange * sinf(m_FovAngle / 2.0f)) };
+	const int nrLanes{ std::max(1, static_cast<int>(ceilf(sweepLength / laneWidth))) };
+
+	// Looking along a short lane sees all of it from one end, a long lane also needs its other end
+	const float laneStart{ -laneLength / 2.0f + std::min(laneWidth, laneLength) / 2.0f };
+	const float laneEnd{ -laneStart };
+	const bool isShortLane{ laneEnd - laneStart < FLT_EPSILON };
+
+	std::vector<Elite::Vector2> tour{};
+	tour.reserve(static_cast<size_t>(nrLanes) * 2);
+
+	for (int lane{}; lane < nrLanes; ++lane)
+	{
+		const float laneOffset{ -sweepLength / 2.0f + (lane + 0.5f) * sweepLength / nrLanes };
+
+		// Every other lane is walked back, the tour snakes through the house
+		const bool isReversed{ lane % 2 == 1 };
+		const float first{ isReversed ? laneEnd : laneStart };
+		const float last{ isReversed ? laneStart : laneEnd };
+
+		tour.push_back(isHorizontal ? Elite::Vector2{ first, laneOffset } : Elite::Vector2{ laneOffset, first });
+		if (!isShortLane) tour.push_back(isHorizontal ? Elite::Vector2{ last, laneOffset } : Elite::Vector2{ laneOffset, last });
+	}
+
+	return tour;
+}
+
+long long SweepPlanner::GetKey(const Elite::Vector2& houseSize) const
+{
+	// Houses that differ less than a meter share their tour
+	const long long x{ static_cast<long long>(roundf(houseSize.x)) };
+	const long long y{ static_cast<long long>(roundf(houseSize.y)) };
+	return (x << 32) ^ (y & 0xFFFFFFFF);
+}
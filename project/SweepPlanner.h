@@ -0,0 +1,32 @@
+#pragma once
+#include <Exam_HelperStructs.h>
+#include <unordered_map>
+
+// Plans the viewpoints the agent walks past to see the whole inside of a house
+// The agent looks where it walks, so the inside is swept in lanes as wide as the fov can see
+// Houses with the same size share a tour, tours are stored relative to the house center
+class SweepPlanner final
+{
+public:
+	// The tours depend on the fov, a different fov forgets every planned tour
+	void SetFov(float fovRange, float fovAngle);
+
+	// Returns the viewpoints of a house with this size, in the order they should be visited
+	const std::vector<Elite::Vector2>& GetTour(const Elite::Vector2& houseSize);
+
+	// Returns the mirroring of the tour that starts closest to the agent
+	Elite::Vector2 GetTourDirection(const Elite::Vector2& houseCenter, const Elite::Vector2& houseSize, const Elite::Vector2& agentPosition);
+private:
+	std::vector<Elite::Vector2> PlanTour(const Elite::Vector2& houseSize) const;
+	long long GetKey(const Elite::Vector2& houseSize) const;
+
+	std::unordered_map<long long, std::vector<Elite::Vector2>> m_Tours{};
+
+	float m_FovRange{};
+	float m_FovAngle{};
+
+	// The walls are part of the house size
+	constexpr static float m_WallThickness{ 2.0f };
+	// Keep the viewpoints away from the walls
+	constexpr static float m_WallMargin{ 1.5f };
+};
@@ -0,0 +1,51 @@
+#include "stdafx.h"
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler(long long frameBudgetMicroseconds)
+	: m_FrameBudget{ frameBudgetMicroseconds }
+{
+}
+
+void TaskScheduler::Submit(const Task& task)
+{
+	m_Tasks.push_back(task);
+}
+
+void TaskScheduler::Update()
+{
+	using Clock = std::chrono::steady_clock;
+
+	const Clock::time_point startTime{ Clock::now() };
+	const std::chrono::microseconds budget{ m_FrameBudget };
+
+	// Give every task a turn until the budget of this frame is used up
+	while (!m_Tasks.empty())
+	{
+		// Continue where the previous frame stopped, so no task starves
+		if (m_NextTask >= m_Tasks.size()) m_NextTask = 0;
+
+		// Remove finished tasks
+		if (m_Tasks[m_NextTask]())
+		{
+			m_Tasks[m_NextTask] = m_Tasks[m_Tasks.size() - 1];
+			m_Tasks.pop_back();
+		}
+		else
+		{
+			++m_NextTask;
+		}
+
+		// Always do at least one step, then stop when out of time
+		if (Clock::now() - startTime >= budget) break;
+	}
+}
+
+bool TaskScheduler::IsIdle() const
+{
+	return m_Tasks.empty();
+}
+
+long long TaskScheduler::GetFrameBudget() const
+{
+	return m_FrameBudget;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <chrono>
+
+class TaskScheduler final
+{
+public:
+	// A task does one small piece of work per call and returns true when it is done
+	using Task = std::function<bool()>;
+
+	TaskScheduler(long long frameBudgetMicroseconds);
+
+	void Submit(const Task& task);
+	void Update();
+
+	bool IsIdle() const;
+	long long GetFrameBudget() const;
+private:
+	std::vector<Task> m_Tasks{};
+	size_t m_NextTask{};
+
+	long long m_FrameBudget{};
+};
@@ -2,61 +2,46 @@
 #include "WorldExplorer.h"
 
 WorldExplorer::WorldExplorer(const WorldInfo& worldInfo)
+	: m_GridSize{ 51 }
+	, m_Discovered{ m_GridSize }
+	, m_AutoDiscovered{ m_GridSize }
 {
-	// Set the gridsize
-	m_GridSize = 51;
-
 	// Set the tile size
 	m_TileSize = worldInfo.Dimensions.x / m_GridSize;
 
 	// Set the left bottom of the world
 	m_LeftBottom = { worldInfo.Center - worldInfo.Dimensions / 2.0f };
-
-	// Reserve the right amount of gridcells
-	m_Grid.reserve(m_GridSize * m_GridSize);
-
-	// Fill the grid
-	for (int y{}; y < m_GridSize; ++y)
-	{
-		for (int x{}; x < m_GridSize; ++x)
-		{
-			m_Grid.emplace_back(ExplorationGridTile{ x, y, false });
-		}
-	}
 }
 
-void WorldExplorer::Update(const Elite::Vector2& playerPosition, float orientation)
+void WorldExplorer::Update(const AgentInfo& agentInfo)
 {
 	// Calcalate the center of the world
 	const Elite::Vector2 center{ m_GridSize / 2.0f * m_TileSize, m_GridSize / 2.0f * m_TileSize };
 
 	// Calculate the player position in grid space
-	const Elite::Vector2 gridPlayerPosition{ playerPosition + center };
+	const Elite::Vector2 gridPlayerPosition{ agentInfo.Position + center };
 	// Calculate the x and y coordinates of the grid cell that the player is in
 	const int playerX{ static_cast<int>(gridPlayerPosition.x / m_TileSize) };
 	const int playerY{ static_cast<int>(gridPlayerPosition.y / m_TileSize) };
 
 	// Set the current grid cell discovered
-	m_Grid[playerY * m_GridSize + playerX].discovered = true;
+	m_Discovered.Set(playerX, playerY);
 	// Reset the autodiscovered of the current grid cell
-	m_Grid[playerY * m_GridSize + playerX].autodiscovered = false;
+	m_AutoDiscovered.Reset(playerX, playerY);
 
-	// The distance that should be check in front of the player
-	constexpr float fovDistance{ 5.0f };
-	// The position to check in front of the player
-	const Elite::Vector2 fovPosition{ gridPlayerPosition.x + cosf(orientation) * fovDistance, gridPlayerPosition.y + sinf(orientation) * fovDistance };
-	// Calculate the x and y coordinates of the grid cell that the fov sees
-	const int fovX{ static_cast<int>(fovPosition.x / m_TileSize) };
-	const int fovY{ static_cast<int>(fovPosition.y / m_TileSize) };
+	// Every tile the agent can see is discovered too
+	m_FovRadius = std::max(static_cast<int>(agentInfo.FOV_Range / m_TileSize + 0.5f), 1);
+	DiscoverFov(gridPlayerPosition / m_TileSize, agentInfo.Orientation, agentInfo.FOV_Range / m_TileSize, agentInfo.FOV_Angle);
 
-	// Set the current grid cell discovered
-	m_Grid[fovY * m_GridSize + fovX].discovered = true;
-	// Reset the autodiscovered of the current grid cell
-	m_Grid[playerY * m_GridSize + playerX].autodiscovered = false;
+	// Look for a new target once the current target is discovered
+	if (m_HasTarget && m_Discovered.Get(m_TargetX, m_TargetY)) m_HasTarget = false;
 }
 
-void WorldExplorer::DrawDebug(IExamInterface* pInterface) const
+void WorldExplorer::DrawDebug(IExamInterface* pInterface, FrameArena& frameArena) const
 {
+	// One rect that every tile reuses, its memory only lives for this frame
+	FrameVector<Elite::Vector2> rect(4, Elite::Vector2{}, FrameAllocator<Elite::Vector2>{ &frameArena });
+
 	// The color that a discovered cell should be
 	const Elite::Vector3 discoveredTileColor
 	{
@@ -74,36 +59,23 @@ void WorldExplorer::DrawDebug(IExamInterface* pInterface) const
 	};
 
 	// For each grid cell
-	for (const ExplorationGridTile& gridTile : m_Grid)
+	for (int y{}; y < m_GridSize; ++y)
 	{
-		// If the cell if not yet discovered, continue to the next cell
-		if (!gridTile.discovered) continue;
-
-		// Create the rect for this tile
-		const std::vector<Elite::Vector2> rect
+		for (int x{}; x < m_GridSize; ++x)
 		{
-			m_LeftBottom + Elite::Vector2{ gridTile.x * m_TileSize, gridTile.y * m_TileSize },
-			m_LeftBottom + Elite::Vector2{ (gridTile.x + 1) * m_TileSize, gridTile.y * m_TileSize },
-			m_LeftBottom + Elite::Vector2{ (gridTile.x + 1) * m_TileSize, (gridTile.y + 1) * m_TileSize },
-			m_LeftBottom + Elite::Vector2{ gridTile.x * m_TileSize, (gridTile.y + 1) * m_TileSize }
-		};
-
-		// Draw the rect
-		pInterface->Draw_Polygon(rect.data(), static_cast<int>(rect.size()), discoveredTileColor);
+			// If the cell if not yet discovered, continue to the next cell
+			if (!m_Discovered.Get(x, y)) continue;
+
+			// Draw the rect for this tile
+			DrawTile(pInterface, rect, static_cast<float>(x), static_cast<float>(y), discoveredTileColor);
+		}
 	}
 
 	// The current tile to search around
 	int curSearchTileX{ m_GridSize / 2 };
 	int curSearchTileY{ m_GridSize / 2 };
 	// The current radius to check
-	int checkRadius{ m_StartSquare };
-
-	// If there are no explore tiles
-	if (m_ExploreTiles.empty())
-	{
-		// Add the square expansion to the radius
-		checkRadius += m_SquareExpansionAmount;
-	}
+	const int checkRadius{ m_ExploreTiles.empty() ? m_WorldSearchRadius : m_HouseSearchRadius };
 
 	if (!m_RevisitTiles.empty()) // If there are revisiting tiles
 	{
@@ -111,19 +83,10 @@ void WorldExplorer::DrawDebug(IExamInterface* pInterface) const
 		for (const Elite::Vector2& tile : m_RevisitTiles)
 		{
 			// If this gridtile is already discovered, continue to the next tile
-			if (m_Grid[static_cast<int>(tile.y) * m_GridSize + static_cast<int>(tile.x)].discovered) continue;
+			if (m_Discovered.Get(static_cast<int>(tile.x), static_cast<int>(tile.y))) continue;
 
-			// Create the rect for this tile
-			const std::vector<Elite::Vector2> rect
-			{
-				m_LeftBottom + Elite::Vector2{ tile.x * m_TileSize, tile.y * m_TileSize },
-				m_LeftBottom + Elite::Vector2{ (tile.x + 1) * m_TileSize, tile.y * m_TileSize },
-				m_LeftBottom + Elite::Vector2{ (tile.x + 1) * m_TileSize, (tile.y + 1) * m_TileSize },
-				m_LeftBottom + Elite::Vector2{ tile.x * m_TileSize, (tile.y + 1) * m_TileSize }
-			};
-
-			// Draw the rect
-			pInterface->Draw_Polygon(rect.data(), static_cast<int>(rect.size()), toBeDiscoveredTileColor);
+			// Draw the rect for this tile
+			DrawTile(pInterface, rect, tile.x, tile.y, toBeDiscoveredTileColor);
 		}
 	}
 	else if(!m_ExploreTiles.empty()) // If there are explore tiles
@@ -145,19 +108,10 @@ void WorldExplorer::DrawDebug(IExamInterface* pInterface) const
 						&& y > curSearchTileY - checkRadius && y < curSearchTileY + checkRadius) continue;
 
 					// If the current tile is already discovered, continue to the next tile
-					if (m_Grid[y * m_GridSize + x].discovered) continue;
-
-					// Create the rect for this tile
-					const std::vector<Elite::Vector2> rect
-					{
-						m_LeftBottom + Elite::Vector2{ x * m_TileSize, y * m_TileSize },
-						m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, y * m_TileSize },
-						m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, (y + 1) * m_TileSize },
-						m_LeftBottom + Elite::Vector2{ x * m_TileSize, (y + 1) * m_TileSize }
-					};
-
-					// Draw the rect
-					pInterface->Draw_Polygon(rect.data(), static_cast<int>(rect.size()), toBeDiscoveredTileColor);
+					if (m_Discovered.Get(x, y)) continue;
+
+					// Draw the rect for this tile
+					DrawTile(pInterface, rect, static_cast<float>(x), static_cast<float>(y), toBeDiscoveredTileColor);
 				}
 			}
 		}
@@ -174,53 +128,127 @@ void WorldExplorer::DrawDebug(IExamInterface* pInterface) const
 					&& y > curSearchTileY - checkRadius && y < curSearchTileY + checkRadius) continue;
 
 				// If the current tile is already discovered, continue to the next tile
-				if (m_Grid[y * m_GridSize + x].discovered) continue;
+				if (m_Discovered.Get(x, y)) continue;
 
-				// Create the rect for this tile
-				const std::vector<Elite::Vector2> rect
-				{
-					m_LeftBottom + Elite::Vector2{ x * m_TileSize, y * m_TileSize },
-					m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, y * m_TileSize },
-					m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, (y + 1) * m_TileSize },
-					m_LeftBottom + Elite::Vector2{ x * m_TileSize, (y + 1) * m_TileSize }
-				};
-
-				// Draw the rect
-				pInterface->Draw_Polygon(rect.data(), static_cast<int>(rect.size()), toBeDiscoveredTileColor);
+				// Draw the rect for this tile
+				DrawTile(pInterface, rect, static_cast<float>(x), static_cast<float>(y), toBeDiscoveredTileColor);
 			}
 		}
 	}
 }
 
-Elite::Vector2 WorldExplorer::GetNearestUndiscoveredGrid(const Elite::Vector2& playerPosition)
+void WorldExplorer::DrawTile(IExamInterface* pInterface, FrameVector<Elite::Vector2>& rect, float x, float y, const Elite::Vector3& color) const
+{
+	rect[0] = m_LeftBottom + Elite::Vector2{ x * m_TileSize, y * m_TileSize };
+	rect[1] = m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, y * m_TileSize };
+	rect[2] = m_LeftBottom + Elite::Vector2{ (x + 1) * m_TileSize, (y + 1) * m_TileSize };
+	rect[3] = m_LeftBottom + Elite::Vector2{ x * m_TileSize, (y + 1) * m_TileSize };
+
+	pInterface->Draw_Polygon(rect.data(), static_cast<int>(rect.size()), color);
+}
+
+void WorldExplorer::StartSearch(const Elite::Vector2& playerPosition)
 {
 	// Calculate the center
-	const ExplorationGridTile& center{ m_Grid[m_Grid.size() / 2] };
+	const int centerTile{ m_GridSize / 2 };
 
 	// Calculate the player position in grid space
 	const Elite::Vector2 playerGridPosition
 	{
-		playerPosition.x / m_TileSize + center.x,
-		playerPosition.y / m_TileSize + center.y
+		playerPosition.x / m_TileSize + centerTile,
+		playerPosition.y / m_TileSize + centerTile
 	};
 
-	// The current go to tile
-	int curX{};
-	int curY{};
-
 	// If we are revisiting buildings and there are revisiting tiles
 	if (m_IsRevisitingBuildings && !m_RevisitTiles.empty())
 	{
-		// If we found a tile, return the position of this tile
-		if (FindRevisitingTile(playerGridPosition, curX, curY)) 
-			return { (curX - m_GridSize / 2) * m_TileSize, (curY - m_GridSize / 2) * m_TileSize };
+		// If we found a tile, there is no need to search
+		int curX{};
+		int curY{};
+		if (FindRevisitingTile(playerGridPosition, curX, curY))
+		{
+			SetTarget(curX, curY);
+			return;
+		}
 	}
-	
-	// Find the closest exploration tile
-	FindExplorationTile(center, playerGridPosition, curX, curY);
 
-	// return the position of this tile
-	return { (curX - m_GridSize / 2) * m_TileSize, (curY - m_GridSize / 2) * m_TileSize };
+	// Start searching around the center of the world
+	m_Search = ExplorationSearch{};
+	m_Search.isSearching = true;
+	m_Search.playerPos = playerGridPosition;
+	m_Search.searchTileX = centerTile;
+	m_Search.searchTileY = centerTile;
+	m_Search.radius = m_WorldSearchRadius;
+
+	// If there are exploring tiles, search around the first explore tile
+	if (!m_ExploreTiles.empty())
+	{
+		m_Search.searchTileX = static_cast<int>(m_ExploreTiles[0].x);
+		m_Search.searchTileY = static_cast<int>(m_ExploreTiles[0].y);
+		m_Search.radius = m_HouseSearchRadius;
+		m_Search.isUsingExploreTiles = true;
+	}
+
+	// The discovery only changes a little during the search, the counts are taken once
+	m_DiscoveredCounts.Build(m_Discovered.GetCells());
+
+	CollectSearchCandidates();
+}
+
+bool WorldExplorer::StepSearch()
+{
+	// Search a limited amount of tiles of the current square
+	for (int nrTiles{}; nrTiles < m_NrTilesPerStep; ++nrTiles)
+	{
+		if (!m_Search.isSearching) return true;
+
+		// If every undiscovered tile of the square is checked
+		if (m_Search.nextCandidate >= m_SearchCandidates.size())
+		{
+			if (FinishSearchSquare()) return true;
+			continue;
+		}
+
+		const Elite::Vector2& tile{ m_SearchCandidates[m_Search.nextCandidate] };
+		SearchTile(static_cast<int>(tile.x), static_cast<int>(tile.y));
+		++m_Search.nextCandidate;
+	}
+
+	return !m_Search.isSearching;
+}
+
+bool WorldExplorer::IsSearching() const
+{
+	return m_Search.isSearching;
+}
+
+bool WorldExplorer::HasTarget() const
+{
+	return m_HasTarget;
+}
+
+Elite::Vector2 WorldExplorer::GetTarget() const
+{
+	return { (m_TargetX - m_GridSize / 2) * m_TileSize, (m_TargetY - m_GridSize / 2) * m_TileSize };
+}
+
+void WorldExplorer::StartRevisiting(const std::vector<Elite::Vector2>& houseCenters)
+{
+	// Stop the current search, the grid is about to change
+	m_Search.isSearching = false;
+	m_HasTarget = false;
+
+	// Reset the discovery of every tile, a row of the grid is cleared a word at a time
+	m_Discovered.Clear();
+
+	// Reset the number of houses
+	m_NrHouses = 0;
+
+	// Add every house as a revisit tile
+	for (const Elite::Vector2& houseCenter : houseCenters)
+	{
+		AddRevisitTile(houseCenter);
+	}
 }
 
 void WorldExplorer::AddExploreTile(const Elite::Vector2& position)
@@ -273,14 +301,32 @@ bool WorldExplorer::IsRevisitingBuildings() const
 
 void WorldExplorer::Reset()
 {
+	// Stop the current search
+	m_Search.isSearching = false;
+	m_HasTarget = false;
+
 	// Reset the number of houses
 	m_NrHouses = 0;
 
 	// Reset the discovery of every tile
-	for (ExplorationGridTile& tile : m_Grid)
-	{
-		tile.discovered = false;
-	}
+	m_Discovered.Clear();
+}
+
+void WorldExplorer::CollectSearchCandidates()
+{
+	m_SearchCandidates.clear();
+	m_Search.nextCandidate = 0;
+
+	// Auto discovering looks at the surrounding tiles, so stay away from the edge of the grid
+	const int minX{ std::max(m_Search.searchTileX - m_Search.radius, 1) };
+	const int minY{ std::max(m_Search.searchTileY - m_Search.radius, 1) };
+	const int maxX{ std::min(m_Search.searchTileX + m_Search.radius, m_GridSize - 2) };
+	const int maxY{ std::min(m_Search.searchTileY + m_Search.radius, m_GridSize - 2) };
+
+	m_Discovered.ForEachUndiscovered(minX, minY, maxX, maxY, [this](int x, int y)
+		{
+			m_SearchCandidates.push_back(Elite::Vector2{ static_cast<float>(x), static_cast<float>(y) });
+		});
 }
 
 bool WorldExplorer::FindRevisitingTile(const Elite::Vector2& playerPos, int& x, int& y)
@@ -301,7 +347,7 @@ bool WorldExplorer::FindRevisitingTile(const Elite::Vector2& playerPos, int& x,
 			const int curSearchTileY{ static_cast<int>(m_RevisitTiles[0].y) };
 
 			// If the current tile is already discovered
-			if (m_Grid[curSearchTileY * m_GridSize + curSearchTileX].discovered)
+			if (m_Discovered.Get(curSearchTileX, curSearchTileY))
 			{
 				// Remove the current tile and continue to the next tile
 				m_RevisitTiles[0] = m_RevisitTiles[m_RevisitTiles.size() - 1];
@@ -322,7 +368,7 @@ bool WorldExplorer::FindRevisitingTile(const Elite::Vector2& playerPos, int& x,
 			const int curSearchTileY{ static_cast<int>(m_RevisitTiles[i].y) };
 
 			// If the current tile is already discovered
-			if (m_Grid[curSearchTileY * m_GridSize + curSearchTileX].discovered)
+			if (m_Discovered.Get(curSearchTileX, curSearchTileY))
 			{
 				// Remove the current tile and continue to the next tile
 				m_RevisitTiles[i] = m_RevisitTiles[m_RevisitTiles.size() - 1];
@@ -349,113 +395,98 @@ bool WorldExplorer::FindRevisitingTile(const Elite::Vector2& playerPos, int& x,
 	return false;
 }
 
-void WorldExplorer::FindExplorationTile(const ExplorationGridTile& center, const Elite::Vector2& playerPos, int& x, int& y)
+void WorldExplorer::SearchTile(int x, int y)
 {
-	// Has found a tile to go to
-	bool hasFoundTile{};
-
-	// The current square radius
-	int radius{ 2 };
-	// The current tile we are searching around
-	int curSearchTileX{ center.x };
-	int curSearchTileY{ center.y };
-
-	// Are we using explore tiles
-	bool isUsingExploreTiles{};
-
-	// If there are exploring tiles
-	if (!m_ExploreTiles.empty())
-	{
-		// Set the search tile to the first explore tile
-		curSearchTileX = static_cast<int>(m_ExploreTiles[0].x);
-		curSearchTileY = static_cast<int>(m_ExploreTiles[0].y);
-		isUsingExploreTiles = true;
-	}
-
-	// The current smallest distance
-	float curDistance{ FLT_MAX };
+	// If the current tile is discovered, continue to the next tile
+	if (m_Discovered.Get(x, y)) return;
 
-	// While you have not found a tile yet
-	while (!hasFoundTile)
-	{
-		// For each tile around the current explore tile
-		for (int curX{ curSearchTileX - radius }; curX <= curSearchTileX + radius; ++curX)
-		{
-			for (int curY{ curSearchTileY - radius }; curY <= curSearchTileY + radius; ++curY)
-			{
-				// If the current tile is not on the boundary of the radius, continue to the next tile
-				if (curX > curSearchTileX - radius && curX < curSearchTileX + radius
-					&& curY > curSearchTileY - radius && curY < curSearchTileY + radius) continue;
+	// Auto discover the current tile
+	AutoDiscoverTile(x, y);
 
-				// If the current tile is discovered, continue to the next tile
-				if (m_Grid[curY * m_GridSize + curX].discovered) continue;
+	// If the current tile is auto discovered, continue to the next tile
+	if (m_Discovered.Get(x, y)) return;
 
-				// Auto discover the current tile
-				AutoDiscoverTile(curX, curY);
+	// If the current score is not better then the best score so far, continue to the next tile
+	const float score{ GetInformationGain(x, y) };
+	if (m_Search.hasFoundTile && score <= m_Search.foundScore) return;
 
-				// If the current tile is auto discovered, continue to the next tile
-				if (m_Grid[curY * m_GridSize + curX].discovered) continue;
+	// Store the current tile and score
+	m_Search.hasFoundTile = true;
+	m_Search.foundX = x;
+	m_Search.foundY = y;
+	m_Search.foundScore = score;
+}
 
-				hasFoundTile = true;
+float WorldExplorer::GetInformationGain(int x, int y) const
+{
+	// The fov is approximated by the square around the tile that it reaches
+	const int minX{ std::max(x - m_FovRadius, 0) };
+	const int minY{ std::max(y - m_FovRadius, 0) };
+	const int maxX{ std::min(x + m_FovRadius, m_GridSize - 1) };
+	const int maxY{ std::min(y + m_FovRadius, m_GridSize - 1) };
+	const int nrTiles{ (maxX - minX + 1) * (maxY - minY + 1) };
+	const int nrUndiscovered{ nrTiles - m_DiscoveredCounts.GetCount(minX, minY, maxX, maxY) };
+
+	// Walking is the cost, a tile right next to the agent costs one tile
+	const float distance{ m_Search.playerPos.Distance(Elite::Vector2(x + 0.5f, y + 0.5f)) };
+	return nrUndiscovered / (1.0f + distance);
+}
 
-				// Calculate the distance between the player and the current tile
-				const float sqrDist{ playerPos.DistanceSquared(Elite::Vector2(curX + 0.5f, curY + 0.5f)) };
+bool WorldExplorer::FinishSearchSquare()
+{
+	// If we found a tile, the search is done
+	if (m_Search.hasFoundTile)
+	{
+		SetTarget(m_Search.foundX, m_Search.foundY);
+		return true;
+	}
 
-				// If the current distance is smaller then the current smallest distance
-				if (sqrDist < curDistance)
-				{
-					// Store the current tile and distance
-					x = curX;
-					y = curY;
-					curDistance = sqrDist;
-				}
-			}
-		}
+	if (m_Search.isUsingExploreTiles) // If using explore tiles
+	{
+		std::cout << "I have checked everything around this building." << "\n";
 
-		// If we found a tile, break the loop
-		if (hasFoundTile) break;
+		// Remove the current explore tile
+		m_ExploreTiles[0] = m_ExploreTiles[m_ExploreTiles.size() - 1];
+		m_ExploreTiles.pop_back();
 
-		if (isUsingExploreTiles) // If using explore tiles
+		if (static_cast<int>(m_ExploreTiles.size()) > 0) // If there are still explore tiles to be checked
 		{
-			std::cout << "I have checked everything around this building." << "\n";
+			std::cout << m_ExploreTiles.size() << " more surroundings of buildings to check.\n";
 
-			// Remove the current explore tile
-			m_ExploreTiles[0] = m_ExploreTiles[m_ExploreTiles.size() - 1];
-			m_ExploreTiles.pop_back();
-
-			if (static_cast<int>(m_ExploreTiles.size()) > 0) // If there are still explore tiles to be checked
-			{
-				std::cout << m_ExploreTiles.size() << " more surroundings of buildings to check.\n";
-				
-				// Set the current search tile to the first explore tile in the container
-				curSearchTileX = static_cast<int>(m_ExploreTiles[0].x);
-				curSearchTileY = static_cast<int>(m_ExploreTiles[0].y);
-			}
-			else // There are no more explore tiles
-			{
-				std::cout << "Continueing world exploration\n";
-				
-				// Set the current search tile to the center of the world
-				curSearchTileX = center.x;
-				curSearchTileY = center.y;
-				isUsingExploreTiles = false;
-			}
+			// Set the current search tile to the first explore tile in the container
+			m_Search.searchTileX = static_cast<int>(m_ExploreTiles[0].x);
+			m_Search.searchTileY = static_cast<int>(m_ExploreTiles[0].y);
 		}
-		else // If we are not using explore tiles
+		else // There are no more explore tiles
 		{
-			if (radius <= m_StartSquare) // If we completed the first square
-			{
-				// Add the square expansion to the radius
-				radius += m_SquareExpansionAmount;
-			}
-			else // If we completed the second square
-			{
-				// Set is done exploring, triggering revisiting
-				m_IsDoneExploring = true;
-				break;
-			}
+			std::cout << "Continueing world exploration\n";
+
+			// Set the current search tile to the center of the world
+			m_Search.searchTileX = m_GridSize / 2;
+			m_Search.searchTileY = m_GridSize / 2;
+			m_Search.radius = m_WorldSearchRadius;
+			m_Search.isUsingExploreTiles = false;
 		}
 	}
+	else // If we are not using explore tiles
+	{
+		// Every tile of the world square is discovered, set is done exploring, triggering revisiting
+		m_IsDoneExploring = true;
+		m_Search.isSearching = false;
+		return true;
+	}
+
+	// Continue with the undiscovered tiles of the next square
+	CollectSearchCandidates();
+	return false;
+}
+
+void WorldExplorer::SetTarget(int x, int y)
+{
+	m_TargetX = x;
+	m_TargetY = y;
+	m_HasTarget = true;
+	m_Search.isSearching = false;
 }
 
 void WorldExplorer::AutoDiscoverTile(int x, int y)
@@ -473,10 +504,10 @@ void WorldExplorer::AutoDiscoverTile(int x, int y)
 			// Discard the center
 			if (!offsetX && !offsetY) continue;
 			// Discard autodiscovered tiles
-			if (m_Grid[(y + offsetY) * m_GridSize + x + offsetX].autodiscovered) continue;
+			if (m_AutoDiscovered.Get(x + offsetX, y + offsetY)) continue;
 
 			// If the surrounding tile is discovered, increment number of discovered surroundings
-			if (m_Grid[(y + offsetY) * m_GridSize + x + offsetX].discovered) ++nrSurroundedDiscovered;
+			if (m_Discovered.Get(x + offsetX, y + offsetY)) ++nrSurroundedDiscovered;
 		}
 	}
 
@@ -484,7 +515,59 @@ void WorldExplorer::AutoDiscoverTile(int x, int y)
 	if (nrSurroundedDiscovered > 1)
 	{
 		// Autodiscover the current tile
-		m_Grid[y * m_GridSize + x].discovered = true;
-		m_Grid[y * m_GridSize + x].autodiscovered = true;
+		m_Discovered.Set(x, y);
+		m_AutoDiscovered.Set(x, y);
+	}
+}
+
+void WorldExplorer::DiscoverFov(const Elite::Vector2& gridPosition, float orientation, float range, float angle)
+{
+	// The edges of the cone, a tile is seen when its center lies left of the right edge and right of the left edge
+	const float halfAngle{ angle / 2.0f };
+	const Elite::Vector2 rightEdge{ cosf(orientation - halfAngle), sinf(orientation - halfAngle) };
+	const Elite::Vector2 leftEdge{ cosf(orientation + halfAngle), sinf(orientation + halfAngle) };
+	// A cone of more than half a circle is not convex, the whole circle is discovered instead
+	const bool isConvex{ angle <= static_cast<float>(E_PI) };
+
+	// The part of the row that is inside the cone, as offsets to the agent
+	float minX{};
+	float maxX{};
+
+	// Keeps the part of the row where a * x + b >= 0
+	const auto clipToEdge{ [&minX, &maxX](float a, float b)
+		{
+			if (a > FLT_EPSILON) minX = std::max(minX, -b / a);
+			else if (a < -FLT_EPSILON) maxX = std::min(maxX, -b / a);
+			else if (b < 0.0f) maxX = minX - 1.0f;
+		} };
+
+	const int firstRow{ std::max(static_cast<int>(floorf(gridPosition.y - range)), 0) };
+	const int lastRow{ std::min(static_cast<int>(floorf(gridPosition.y + range)), m_GridSize - 1) };
+	for (int y{ firstRow }; y <= lastRow; ++y)
+	{
+		// The offset of the tile centers of this row to the agent
+		const float offsetY{ y + 0.5f - gridPosition.y };
+		if (fabsf(offsetY) > range) continue;
+
+		// The circle limits the row to a run around the agent
+		const float halfWidth{ sqrtf(range * range - offsetY * offsetY) };
+		minX = -halfWidth;
+		maxX = halfWidth;
+
+		// Both edges bound the run on one side, the bound moves by the same amount every row
+		if (isConvex)
+		{
+			clipToEdge(-rightEdge.y, rightEdge.x * offsetY);
+			clipToEdge(leftEdge.y, -leftEdge.x * offsetY);
+		}
+
+		// The tiles whose center lies in the run
+		const int firstX{ std::max(static_cast<int>(ceilf(gridPosition.x + minX - 0.5f)), 0) };
+		const int lastX{ std::min(static_cast<int>(floorf(gridPosition.x + maxX - 0.5f)), m_GridSize - 1) };
+		if (firstX > lastX) continue;
+
+		// Seen tiles are discovered for real
+		m_Discovered.SetRun(y, firstX, lastX);
+		m_AutoDiscovered.ResetRun(y, firstX, lastX);
 	}
 }
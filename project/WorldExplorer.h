@@ -1,33 +1,65 @@
 #pragma once
 #include <Exam_HelperStructs.h>
 #include <IExamInterface.h>
+#include "FrameArena.h"
+#include "BitGrid.h"
+#include "DiscoveryPyramid.h"
+#include "SummedAreaTable.h"
 
 class WorldExplorer final
 {
 public:
 	WorldExplorer(const WorldInfo& worldInfo);
 
-	void Update(const Elite::Vector2& playerPosition, float orientation);
+	// Discovers every tile the fov cone of the agent covers
+	void Update(const AgentInfo& agentInfo);
 
-	void DrawDebug(IExamInterface* pInterface) const;
-	Elite::Vector2 GetNearestUndiscoveredGrid(const Elite::Vector2& playerPosition);
+	void DrawDebug(IExamInterface* pInterface, FrameArena& frameArena) const;
 	void AddExploreTile(const Elite::Vector2& position);
 	void AddRevisitTile(const Elite::Vector2& position);
 	bool IsDoneExploring() const;
 	bool IsRevisitingBuildings() const;
 	void Reset();
+
+	// The search for the undiscovered tile that reveals the most per distance walked is spread over multiple frames
+	void StartSearch(const Elite::Vector2& playerPosition);
+	bool StepSearch();
+	bool IsSearching() const;
+	bool HasTarget() const;
+	Elite::Vector2 GetTarget() const;
+
+	// Resets the grid at once, clearing it costs a few words per row
+	void StartRevisiting(const std::vector<Elite::Vector2>& houseCenters);
 private:
-	struct ExplorationGridTile
+	// Where the search for an exploration tile continues in the next step
+	struct ExplorationSearch
 	{
-		int x{};
-		int y{};
-		bool discovered{};
-		bool autodiscovered{};
+		bool isSearching{};
+		Elite::Vector2 playerPos{};
+		int searchTileX{};
+		int searchTileY{};
+		int radius{};
+		bool isUsingExploreTiles{};
+		size_t nextCandidate{};
+		bool hasFoundTile{};
+		int foundX{};
+		int foundY{};
+		float foundScore{};
 	};
 
+	// Collects the undiscovered tiles of the current square, discovered parts of the square are skipped as a whole
+	void CollectSearchCandidates();
 	bool FindRevisitingTile(const Elite::Vector2& playerPos, int& x, int& y);
-	void FindExplorationTile(const ExplorationGridTile& center, const Elite::Vector2& playerPos, int& x, int& y);
+	void SearchTile(int x, int y);
+	// The undiscovered tiles the fov would reveal from this tile, per tile walked to get there
+	float GetInformationGain(int x, int y) const;
+	bool FinishSearchSquare();
+	void SetTarget(int x, int y);
 	void AutoDiscoverTile(int x, int y);
+	// Rasterizes the fov cone row by row, the cone covers one run of tiles per row
+	void DiscoverFov(const Elite::Vector2& gridPosition, float orientation, float range, float angle);
+	// Fills the rect with the corners of the tile and draws it
+	void DrawTile(IExamInterface* pInterface, FrameVector<Elite::Vector2>& rect, float x, float y, const Elite::Vector3& color) const;
 
 	std::vector<Elite::Vector2> m_ExploreTiles{};
 	std::vector<Elite::Vector2> m_RevisitTiles{};
@@ -38,9 +70,26 @@ private:
 	Elite::Vector2 m_LeftBottom{};
 	float m_TileSize{};
 	int m_GridSize{};
-	std::vector<ExplorationGridTile> m_Grid{};
+	DiscoveryPyramid m_Discovered;
+	// Tiles that are only discovered because their neighbours are, they do not count as discovered neighbours
+	BitGrid m_AutoDiscovered;
+	// Counts the discovered tiles around a search candidate, built when a search starts
+	SummedAreaTable m_DiscoveredCounts{};
+	// The tiles of the current square that are left to score, kept between searches so it does not allocate again
+	std::vector<Elite::Vector2> m_SearchCandidates{};
+	// How many tiles the fov reaches
+	int m_FovRadius{ 1 };
+
+	ExplorationSearch m_Search{};
+	bool m_HasTarget{};
+	int m_TargetX{};
+	int m_TargetY{};
+
+	// Amount of work done in one step of a sliced task
+	const int m_NrTilesPerStep{ 64 };
 
-	const int m_StartSquare{ 2 };
-	const int m_SquareExpansionAmount{ 10 };
+	// The square around a new house that is explored first, and the square around the center of the world
+	const int m_HouseSearchRadius{ 2 };
+	const int m_WorldSearchRadius{ 12 };
 };
 